@@ -0,0 +1,77 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "base58.h"
+#include "hash.h"
+#include "key.h"
+#include "rpcpog.h"
+#include "script/standard.h"
+#include "utilstrencodings.h"
+#include "validation.h"
+
+// Signature checks of an ABN transaction with ABN_BENCH_OUTPUTS outputs, signed by
+// the owner of the last output (or by nobody), comparing the old per-output
+// CheckStakeSignature loop with the single recovery in CheckTxMessageSignature.
+
+static const int ABN_BENCH_OUTPUTS = 8;
+
+static CTransactionRef MakeABNBenchTx(bool fSigned)
+{
+    std::vector<CKey> keys(ABN_BENCH_OUTPUTS);
+    CMutableTransaction tx;
+    tx.vout.resize(ABN_BENCH_OUTPUTS);
+    for (int i = 0; i < ABN_BENCH_OUTPUTS; i++) {
+        keys[i].MakeNewKey(true);
+        tx.vout[i].nValue = COIN;
+        tx.vout[i].scriptPubKey = GetScriptForDestination(keys[i].GetPubKey().GetID());
+    }
+    CKey signer;
+    if (fSigned) {
+        signer = keys.back();
+    } else {
+        signer.MakeNewKey(true);
+    }
+    std::string sMessage = "<MT>ABN</MT><abncpk>bench</abncpk>";
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << strMessageMagic;
+    ss << sMessage;
+    std::vector<unsigned char> vchSig;
+    signer.SignCompact(ss.GetHash(), vchSig);
+    tx.vout[0].sTxOutMessage = "<abnmsg>" + sMessage + "</abnmsg><abnsig>" + EncodeBase64(vchSig.data(), vchSig.size()) + "</abnsig>";
+    return MakeTransactionRef(std::move(tx));
+}
+
+static bool CheckABNSignaturePerOutput(const CTransactionRef& tx)
+{
+    std::string sXML = GetTransactionMessage(tx);
+    std::string sSig = ExtractXML(sXML, "<abnsig>", "</abnsig>");
+    std::string sMessage = ExtractXML(sXML, "<abnmsg>", "</abnmsg>");
+    for (const CTxOut& txout : tx->vout) {
+        std::string sError;
+        if (CheckStakeSignature(PubKeyToAddress(txout.scriptPubKey), sSig, sMessage, sError))
+            return true;
+    }
+    return false;
+}
+
+static void ABNSignatureBench(benchmark::State& state, bool fSigned, bool fPerOutput)
+{
+    CTransactionRef tx = MakeABNBenchTx(fSigned);
+    while (state.KeepRunning()) {
+        bool fValid = fPerOutput ? CheckABNSignaturePerOutput(tx) : CheckTxMessageSignature(tx, "abn");
+        assert(fValid == fSigned);
+    }
+}
+
+static void ABNSignature_Signed_PerOutput(benchmark::State& state) { ABNSignatureBench(state, true, true); }
+static void ABNSignature_Signed(benchmark::State& state) { ABNSignatureBench(state, true, false); }
+static void ABNSignature_Unsigned_PerOutput(benchmark::State& state) { ABNSignatureBench(state, false, true); }
+static void ABNSignature_Unsigned(benchmark::State& state) { ABNSignatureBench(state, false, false); }
+
+BENCHMARK(ABNSignature_Signed_PerOutput);
+BENCHMARK(ABNSignature_Signed);
+BENCHMARK(ABNSignature_Unsigned_PerOutput);
+BENCHMARK(ABNSignature_Unsigned);
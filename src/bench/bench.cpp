@@ -39,6 +39,11 @@ benchmark::BenchRunner::RunAll(double elapsedTimeForOne)
     perf_fini();
 }
 
+void benchmark::State::ReportValue(const std::string& label, uint64_t value)
+{
+    std::cout << name << "-" << label << "," << value << "\n";
+}
+
 bool benchmark::State::KeepRunning()
 {
     if (count & countMask) {
@@ -57,6 +57,8 @@ namespace benchmark {
             countMaskInv = 1./(countMask + 1);
         }
         bool KeepRunning();
+        /** Report a measurement other than time (e.g. a size) along with the results */
+        void ReportValue(const std::string& label, uint64_t value);
     };
 
     typedef boost::function<void(State&)> BenchFunction;
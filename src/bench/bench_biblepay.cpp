@@ -4,7 +4,10 @@
 
 #include "bench.h"
 
+#include "crypto/sha256.h"
+#include "crypto/x11.h"
 #include "key.h"
+#include "messagesigcache.h"
 #include "stacktraces.h"
 #include "validation.h"
 #include "util.h"
@@ -20,8 +23,11 @@ main(int argc, char** argv)
     RegisterPrettySignalHandlers();
     RegisterPrettyTerminateHander();
 
+    SHA256AutoDetect();
+    X11AutoDetect();
     ECC_Start();
     ECCVerifyHandle verifyHandle;
+    InitMessageSignatureCache();
 
     BLSInit();
     SetupEnvironment();
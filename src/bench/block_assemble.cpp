@@ -0,0 +1,100 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "chainparams.h"
+#include "miner.h"
+#include "random.h"
+#include "txmempool.h"
+#include "validation.h"
+
+#include "llmq/quorums_chainlocks.h"
+
+// Compares selecting the transactions of a block template from scratch with
+// extending the previous selection, as getblocktemplate and the stratum server
+// do between two blocks. Every iteration one transaction enters the mempool.
+// BlockAssemble_Packages selects from scratch out of a mempool where every
+// tenth transaction has a child, next to the independent ones.
+
+static const int BLOCK_ASSEMBLE_MEMPOOL_TXS = 10000;
+
+static uint256 AddBenchTx(CTxMemPool& pool, int i, const uint256& hashPrev = uint256())
+{
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].prevout = COutPoint(hashPrev.IsNull() ? GetRandHash() : hashPrev, 0);
+    tx.vin[0].scriptSig = CScript() << OP_1;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+    tx.vout[0].nValue = 10 * COIN;
+    CAmount nFee = 1000 + (i % 97) * 100;
+    LockPoints lp;
+    pool.addUnchecked(tx.GetHash(), CTxMemPoolEntry(MakeTransactionRef(tx), nFee, 0, 1, false, 1, lp));
+    return tx.GetHash();
+}
+
+static void BlockAssembleBench(benchmark::State& state, bool fNewTip)
+{
+    // Asked by the assembler whether transactions are safe to mine. Considers all of
+    // them safe with the default sporks (no LLMQ based InstantSend)
+    llmq::CChainLocksHandler chainLocksHandler(nullptr);
+    llmq::chainLocksHandler = &chainLocksHandler;
+
+    for (int i = 0; i < BLOCK_ASSEMBLE_MEMPOOL_TXS; i++)
+        AddBenchTx(mempool, i);
+
+    BlockAssembler::Options options;
+    options.fUseCandidate = true;
+    BlockAssembler assembler(Params(CBaseChainParams::MAIN), options);
+    blockCandidate.Invalidate();
+
+    uint256 hashTip = GetRandHash();
+    int i = BLOCK_ASSEMBLE_MEMPOOL_TXS;
+    while (state.KeepRunning()) {
+        AddBenchTx(mempool, i++);
+        if (fNewTip)
+            hashTip = GetRandHash();
+        std::unique_ptr<CBlockTemplate> pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+        assert(pblocktemplate->block.vtx.size() > BLOCK_ASSEMBLE_MEMPOOL_TXS);
+    }
+
+    blockCandidate.Invalidate();
+    mempool.clear();
+    llmq::chainLocksHandler = nullptr;
+}
+
+static void BlockAssemble_Full(benchmark::State& state) { BlockAssembleBench(state, true); }
+static void BlockAssemble_Incremental(benchmark::State& state) { BlockAssembleBench(state, false); }
+
+static void BlockAssemble_Packages(benchmark::State& state)
+{
+    llmq::CChainLocksHandler chainLocksHandler(nullptr);
+    llmq::chainLocksHandler = &chainLocksHandler;
+
+    // Depending on which of the two pays more, a package is selected as a whole
+    // or its child later through the modified entries
+    int nTxs = 0;
+    for (int i = 0; i < BLOCK_ASSEMBLE_MEMPOOL_TXS; i++) {
+        uint256 hash = AddBenchTx(mempool, i);
+        nTxs++;
+        if (i % 10 == 0) {
+            AddBenchTx(mempool, i + 50, hash);
+            nTxs++;
+        }
+    }
+
+    BlockAssembler::Options options;
+    BlockAssembler assembler(Params(CBaseChainParams::MAIN), options);
+    while (state.KeepRunning()) {
+        std::unique_ptr<CBlockTemplate> pblocktemplate = assembler.SelectTransactions(GetRandHash(), 2, 0);
+        assert(pblocktemplate->block.vtx.size() == (size_t)nTxs + 1);
+    }
+
+    mempool.clear();
+    llmq::chainLocksHandler = nullptr;
+}
+
+BENCHMARK(BlockAssemble_Full);
+BENCHMARK(BlockAssemble_Incremental);
+BENCHMARK(BlockAssemble_Packages);
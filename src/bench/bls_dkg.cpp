@@ -25,6 +25,12 @@ struct DKG
 
     BLSVerificationVectorPtr quorumVvec;
 
+    // only initialized for Bench_Pipeline
+    uint256 commitmentHash;
+    std::vector<CBLSPublicKey> operatorPubKeys;
+    std::vector<CBLSSignature> commitmentSigs; // signed with the operator keys
+    std::vector<CBLSSignature> quorumSigs; // signed with the secret key shares of the members
+
     DKG(int quorumSize)
     {
         members.resize(quorumSize);
@@ -109,6 +115,104 @@ struct DKG
             memberIdx = (memberIdx + 1) % members.size();
         }
     }
+
+    void InitPipeline()
+    {
+        if (!quorumSigs.empty()) {
+            return;
+        }
+
+        ReceiveVvecs();
+        commitmentHash = GetRandHash();
+        for (size_t i = 0; i < members.size(); i++) {
+            CBLSSecretKey operatorKey;
+            operatorKey.MakeNewKey();
+            operatorPubKeys.emplace_back(operatorKey.GetPublicKey());
+            commitmentSigs.emplace_back(operatorKey.Sign(commitmentHash));
+
+            ReceiveShares(i);
+            quorumSigs.emplace_back(blsWorker.AggregateSecretKeys(receivedSkShares).Sign(commitmentHash));
+        }
+    }
+
+    // A whole DKG round as seen by a single member: verification of all contributions with a few invalid shares,
+    // verification of the justifications for these, building the quorum vvec and our secret key share, verification of
+    // the premature commitments of all members and finally aggregation of the final commitment
+    void Bench_Pipeline(benchmark::State& state, int invalidCount, bool parallel)
+    {
+        InitPipeline();
+
+        size_t memberIdx = 0;
+        while (state.KeepRunning()) {
+            auto& m = members[memberIdx];
+
+            // contribution and complaint phase
+            ReceiveShares(memberIdx);
+            std::set<size_t> invalidIndexes;
+            for (int i = 0; i < invalidCount; i++) {
+                int shareIdx = GetRandInt(receivedSkShares.size());
+                receivedSkShares[shareIdx].MakeNewKey();
+                invalidIndexes.emplace(shareIdx);
+            }
+            VerifyContributionShares(memberIdx, invalidIndexes, parallel, true);
+
+            // justification phase, the complained members send the correct shares
+            std::list<std::future<bool>> futures;
+            for (size_t idx : invalidIndexes) {
+                receivedSkShares[idx] = members[idx].skShares[memberIdx];
+                futures.emplace_back(blsWorker.AsyncVerifyContributionShare(m.id, receivedVvecs[idx], receivedSkShares[idx]));
+            }
+            for (auto& f : futures) {
+                assert(f.get());
+            }
+
+            // commit phase
+            BuildQuorumVerificationVector(parallel);
+            CBLSSecretKey skShare = blsWorker.AggregateSecretKeys(receivedSkShares, 0, 0, parallel);
+            assert(skShare.Sign(commitmentHash) == quorumSigs[memberIdx]);
+
+            std::vector<char> valid(members.size());
+            std::vector<std::function<void()>> jobs;
+            for (size_t i = 0; i < members.size(); i++) {
+                jobs.emplace_back([&, i]() {
+                    CBLSPublicKey pubKeyShare = blsWorker.BuildPubKeyShare(quorumVvec, members[i].id);
+                    valid[i] = quorumSigs[i].VerifyInsecure(pubKeyShare, commitmentHash);
+                });
+            }
+            if (parallel) {
+                blsWorker.RunJobs(jobs);
+            } else {
+                for (const auto& job : jobs) {
+                    job();
+                }
+            }
+            for (size_t i = 0; i < members.size(); i++) {
+                assert(valid[i]);
+            }
+
+            // finalization phase
+            CBLSSignature membersSig;
+            CBLSSignature quorumSig;
+            bool recovered = false;
+            std::vector<std::function<void()>> finalizeJobs;
+            finalizeJobs.emplace_back([&]() {
+                membersSig = CBLSSignature::AggregateSecure(commitmentSigs, operatorPubKeys, commitmentHash);
+            });
+            finalizeJobs.emplace_back([&]() {
+                recovered = quorumSig.Recover(quorumSigs, ids);
+            });
+            if (parallel) {
+                blsWorker.RunJobs(finalizeJobs);
+            } else {
+                for (const auto& job : finalizeJobs) {
+                    job();
+                }
+            }
+            assert(recovered && membersSig.IsValid());
+
+            memberIdx = (memberIdx + 1) % members.size();
+        }
+    }
 };
 
 std::shared_ptr<DKG> dkg10;
@@ -179,3 +283,22 @@ BENCH_VerifyContributionShares(parallel, 400, 5, true, false)
 BENCH_VerifyContributionShares(parallel_aggregated, 10, 5, true, true)
 BENCH_VerifyContributionShares(parallel_aggregated, 100, 5, true, true)
 BENCH_VerifyContributionShares(parallel_aggregated, 400, 5, true, true)
+
+///////////////////////////////
+
+
+
+#define BENCH_Pipeline(name, quorumSize, invalidCount, parallel) \
+    static void BLSDKG_Pipeline_##name##_##quorumSize(benchmark::State& state) \
+    { \
+        InitIfNeeded(); \
+        dkg##quorumSize->Bench_Pipeline(state, invalidCount, parallel); \
+    } \
+    BENCHMARK(BLSDKG_Pipeline_##name##_##quorumSize)
+
+BENCH_Pipeline(simple, 10, 2, false)
+BENCH_Pipeline(simple, 100, 5, false)
+BENCH_Pipeline(simple, 400, 5, false)
+BENCH_Pipeline(parallel, 10, 2, true)
+BENCH_Pipeline(parallel, 100, 5, true)
+BENCH_Pipeline(parallel, 400, 5, true)
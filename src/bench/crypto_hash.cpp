@@ -14,6 +14,7 @@
 #include "crypto/sha1.h"
 #include "crypto/sha256.h"
 #include "crypto/sha512.h"
+#include "crypto/x11.h"
 
 /* Number of bytes to hash per iteration */
 static const uint64_t BUFFER_SIZE = 1000*1000;
@@ -70,6 +71,19 @@ static void HASH_DSHA256_0032b(benchmark::State& state)
     }
 }
 
+static void SHA256D64Bench(benchmark::State& state, size_t nBlocks)
+{
+    std::vector<uint8_t> in(64 * nBlocks, 0);
+    std::vector<uint8_t> out(32 * nBlocks);
+    while (state.KeepRunning())
+        SHA256D64(out.data(), in.data(), nBlocks);
+}
+
+static void HASH_SHA256D64_1024(benchmark::State& state)
+{
+    SHA256D64Bench(state, 1024);
+}
+
 static void HASH_SHA512(benchmark::State& state)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -186,6 +200,77 @@ static void HASH_X11_2048b_single(benchmark::State& state)
         hash = HashX11(in.begin(), in.end());
 }
 
+// 2000 header preimages, the size of a full headers message
+static void X11HeadersBench(benchmark::State& state, bool fBatch)
+{
+    const size_t nHeaders = 2000;
+    std::vector<uint8_t> in(nHeaders * 80);
+    for (size_t i = 0; i < in.size(); i++)
+        in[i] = (uint8_t)(i * 31);
+    std::vector<uint256> out(nHeaders);
+    while (state.KeepRunning()) {
+        if (fBatch) {
+            HashX11Batch(in.data(), 80, nHeaders, out.data());
+        } else {
+            for (size_t i = 0; i < nHeaders; i++)
+                out[i] = HashX11(in.begin() + i * 80, in.begin() + (i + 1) * 80);
+        }
+    }
+}
+
+static void HASH_X11_Headers2000(benchmark::State& state)
+{
+    X11HeadersBench(state, false);
+}
+
+static void HASH_X11_Headers2000_batch(benchmark::State& state)
+{
+    X11HeadersBench(state, true);
+}
+
+// Same as above for the X11 stages that have optimized versions
+static void X11Variant(benchmark::State& state, bool fUseOptimized, void (*bench)(benchmark::State&))
+{
+    X11AutoDetect(fUseOptimized);
+    bench(state);
+    X11AutoDetect();
+}
+
+#define X11_VARIANT_BENCHMARKS(name, fUseOptimized) \
+    static void HASH_X11_0080b_##name(benchmark::State& state) { X11Variant(state, fUseOptimized, HASH_X11_0080b_single); } \
+    static void HASH_X11_Headers2000_##name(benchmark::State& state) { X11Variant(state, fUseOptimized, HASH_X11_Headers2000_batch); } \
+    BENCHMARK(HASH_X11_0080b_##name); \
+    BENCHMARK(HASH_X11_Headers2000_##name);
+
+X11_VARIANT_BENCHMARKS(standard, false)
+X11_VARIANT_BENCHMARKS(optimized, true)
+
+// Run a benchmark with the SHA256 transforms restricted to one implementation, so that the
+// variants can be compared on the same machine. Variants the CPU lacks fall back to standard.
+static void SHA256Variant(benchmark::State& state, sha256_implementation::UseImplementation implementation, void (*bench)(benchmark::State&))
+{
+    SHA256AutoDetect(implementation);
+    bench(state);
+    SHA256AutoDetect();
+}
+
+#define SHA256_VARIANT_BENCHMARKS(name, implementation) \
+    static void HASH_SHA256_##name(benchmark::State& state) { SHA256Variant(state, implementation, HASH_SHA256); } \
+    static void HASH_DSHA256_##name(benchmark::State& state) { SHA256Variant(state, implementation, HASH_DSHA256); } \
+    static void HASH_SHA256_0032b_##name(benchmark::State& state) { SHA256Variant(state, implementation, HASH_SHA256_0032b); } \
+    static void HASH_DSHA256_0032b_##name(benchmark::State& state) { SHA256Variant(state, implementation, HASH_DSHA256_0032b); } \
+    static void HASH_SHA256D64_1024_##name(benchmark::State& state) { SHA256Variant(state, implementation, HASH_SHA256D64_1024); } \
+    BENCHMARK(HASH_SHA256_##name); \
+    BENCHMARK(HASH_DSHA256_##name); \
+    BENCHMARK(HASH_SHA256_0032b_##name); \
+    BENCHMARK(HASH_DSHA256_0032b_##name); \
+    BENCHMARK(HASH_SHA256D64_1024_##name);
+
+SHA256_VARIANT_BENCHMARKS(standard, sha256_implementation::STANDARD)
+SHA256_VARIANT_BENCHMARKS(sse41, sha256_implementation::USE_SSE41)
+SHA256_VARIANT_BENCHMARKS(avx2, sha256_implementation::USE_AVX2)
+SHA256_VARIANT_BENCHMARKS(shani, sha256_implementation::USE_SHANI)
+
 BENCHMARK(HASH_RIPEMD160);
 BENCHMARK(HASH_SHA1);
 BENCHMARK(HASH_SHA256);
@@ -195,6 +280,7 @@ BENCHMARK(HASH_X11);
 
 BENCHMARK(HASH_SHA256_0032b);
 BENCHMARK(HASH_DSHA256_0032b);
+BENCHMARK(HASH_SHA256D64_1024);
 BENCHMARK(HASH_SipHash_0032b);
 
 BENCHMARK(HASH_DSHA256_0032b_single);
@@ -209,3 +295,5 @@ BENCHMARK(HASH_X11_0128b_single);
 BENCHMARK(HASH_X11_0512b_single);
 BENCHMARK(HASH_X11_1024b_single);
 BENCHMARK(HASH_X11_2048b_single);
+BENCHMARK(HASH_X11_Headers2000);
+BENCHMARK(HASH_X11_Headers2000_batch);
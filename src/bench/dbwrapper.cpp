@@ -0,0 +1,84 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "dbwrapper.h"
+#include "random.h"
+#include "uint256.h"
+#include "util.h"
+
+#include <boost/filesystem.hpp>
+
+// Compares LevelDB compression settings on records shaped like the address index:
+// (type, address hash, height, txid, output index) -> amount. The bench has no chain
+// data to work on; for that, start a node on a copy of a real datadir with
+// -dbcompression and -forcecompactdb and compare the database sizes.
+
+static const int DB_BENCH_RECORDS = 20000;
+
+typedef std::pair<std::pair<char, uint160>, std::pair<int, std::pair<uint256, unsigned int> > > DBBenchKey;
+
+static DBBenchKey MakeDBBenchKey(int i)
+{
+    // A few hundred addresses receiving many payments, as with pool and GSC payouts
+    uint160 addr;
+    *(uint32_t*)addr.begin() = i % 300;
+    uint256 txid = GetRandHash();
+    return std::make_pair(std::make_pair('a', addr), std::make_pair(i, std::make_pair(txid, (unsigned int)(i % 4))));
+}
+
+static uint64_t DBBenchDiskSize(const boost::filesystem::path& path)
+{
+    uint64_t nSize = 0;
+    for (boost::filesystem::recursive_directory_iterator it(path), end; it != end; ++it) {
+        if (boost::filesystem::is_regular_file(it->status()))
+            nSize += boost::filesystem::file_size(it->path());
+    }
+    return nSize;
+}
+
+static void DBWrapperBench(benchmark::State& state, const std::string& strCompression, bool fRead)
+{
+    ForceSetMultiArgs("-dbcompression", {strCompression});
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("bench_biblepay_db_%%%%%%%%");
+    std::vector<DBBenchKey> vKeys;
+    vKeys.reserve(DB_BENCH_RECORDS);
+    for (int i = 0; i < DB_BENCH_RECORDS; i++)
+        vKeys.push_back(MakeDBBenchKey(i));
+    {
+        CDBWrapper db(path, 8 << 20, false, true);
+        if (fRead) {
+            CDBBatch batch(db);
+            for (int i = 0; i < DB_BENCH_RECORDS; i++)
+                batch.Write(vKeys[i], (int64_t)i * 1000);
+            db.WriteBatch(batch, true);
+            db.CompactFull();
+        }
+        int i = 0;
+        int64_t nValue;
+        while (state.KeepRunning()) {
+            if (fRead) {
+                bool fFound = db.Read(vKeys[GetRand(DB_BENCH_RECORDS)], nValue);
+                assert(fFound);
+            } else {
+                db.Write(vKeys[i % DB_BENCH_RECORDS], (int64_t)i * 1000);
+            }
+            i++;
+        }
+        db.CompactFull();
+        state.ReportValue("disksize", DBBenchDiskSize(path));
+    }
+    boost::filesystem::remove_all(path);
+    ForceRemoveArg("-dbcompression");
+}
+
+static void DBWrapper_Write_None(benchmark::State& state) { DBWrapperBench(state, "none", false); }
+static void DBWrapper_Write_Snappy(benchmark::State& state) { DBWrapperBench(state, "snappy", false); }
+static void DBWrapper_Read_None(benchmark::State& state) { DBWrapperBench(state, "none", true); }
+static void DBWrapper_Read_Snappy(benchmark::State& state) { DBWrapperBench(state, "snappy", true); }
+
+BENCHMARK(DBWrapper_Write_None);
+BENCHMARK(DBWrapper_Write_Snappy);
+BENCHMARK(DBWrapper_Read_None);
+BENCHMARK(DBWrapper_Read_Snappy);
@@ -0,0 +1,49 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "consensus/merkle.h"
+#include "primitives/block.h"
+#include "random.h"
+#include "uint256.h"
+
+static void MerkleRoot(benchmark::State& state)
+{
+    std::vector<uint256> leaves(9001);
+    for (auto& item : leaves)
+        item = GetRandHash();
+    while (state.KeepRunning()) {
+        bool mutation = false;
+        uint256 hash = ComputeMerkleRoot(leaves, &mutation);
+        leaves[mutation] = hash;
+    }
+}
+
+// Extranonce updates on a 2000 transaction template: full rebuild vs the cached coinbase branch
+static void MerkleRootExtraNonce(benchmark::State& state, bool fBranch)
+{
+    CBlock block;
+    block.vtx.resize(2000);
+    for (size_t i = 0; i < block.vtx.size(); i++) {
+        CMutableTransaction mtx;
+        mtx.vin.resize(1);
+        mtx.vin[0].prevout.hash = GetRandHash();
+        block.vtx[i] = MakeTransactionRef(std::move(mtx));
+    }
+    std::vector<uint256> vBranch = BlockMerkleBranch(block, 0);
+    unsigned int nExtraNonce = 0;
+    while (state.KeepRunning()) {
+        CMutableTransaction coinbase(*block.vtx[0]);
+        coinbase.vin[0].scriptSig = CScript() << ++nExtraNonce;
+        block.vtx[0] = MakeTransactionRef(std::move(coinbase));
+        block.hashMerkleRoot = fBranch ? BlockMerkleRootFromCoinbaseBranch(block, vBranch) : BlockMerkleRoot(block);
+    }
+}
+
+static void MerkleRootExtraNonce_Full(benchmark::State& state) { MerkleRootExtraNonce(state, false); }
+static void MerkleRootExtraNonce_Branch(benchmark::State& state) { MerkleRootExtraNonce(state, true); }
+
+BENCHMARK(MerkleRoot);
+BENCHMARK(MerkleRootExtraNonce_Full);
+BENCHMARK(MerkleRootExtraNonce_Branch);
@@ -0,0 +1,84 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "blockcache.h"
+
+#include "serialize.h"
+#include "version.h"
+
+CRecentBlockCache recentBlockCache(DEFAULT_MAX_BLOCK_CACHE << 20);
+
+CRecentBlockCache::CRecentBlockCache(size_t nMaxBytesIn) :
+    nBytes(0),
+    nMaxBytes(nMaxBytesIn),
+    nHits(0),
+    nMisses(0)
+{
+}
+
+void CRecentBlockCache::SetMaxBytes(size_t nMaxBytesIn)
+{
+    LOCK(cs);
+    nMaxBytes = nMaxBytesIn;
+    Trim();
+}
+
+void CRecentBlockCache::Trim()
+{
+    AssertLockHeld(cs);
+    while (nBytes > nMaxBytes && !listEntries.empty()) {
+        const Entry& entry = listEntries.back();
+        nBytes -= entry.nSize;
+        mapEntries.erase(entry.hash);
+        listEntries.pop_back();
+    }
+}
+
+void CRecentBlockCache::Insert(const uint256& hash, const std::shared_ptr<const CBlock>& pblock, bool fCheckedPoW)
+{
+    if (!pblock)
+        return;
+    size_t nSize = ::GetSerializeSize(*pblock, SER_NETWORK, PROTOCOL_VERSION);
+
+    LOCK(cs);
+    if (nSize > nMaxBytes)
+        return;
+    auto it = mapEntries.find(hash);
+    if (it != mapEntries.end()) {
+        it->second->fCheckedPoW |= fCheckedPoW;
+        listEntries.splice(listEntries.begin(), listEntries, it->second);
+        return;
+    }
+    listEntries.push_front(Entry{hash, pblock, nSize, fCheckedPoW});
+    mapEntries.emplace(hash, listEntries.begin());
+    nBytes += nSize;
+    Trim();
+}
+
+std::shared_ptr<const CBlock> CRecentBlockCache::Get(const uint256& hash, bool fRequirePoW)
+{
+    LOCK(cs);
+    auto it = mapEntries.find(hash);
+    if (it == mapEntries.end() || (fRequirePoW && !it->second->fCheckedPoW)) {
+        nMisses++;
+        return nullptr;
+    }
+    nHits++;
+    listEntries.splice(listEntries.begin(), listEntries, it->second);
+    return it->second->pblock;
+}
+
+void CRecentBlockCache::Clear()
+{
+    LOCK(cs);
+    listEntries.clear();
+    mapEntries.clear();
+    nBytes = 0;
+}
+
+CRecentBlockCache::Stats CRecentBlockCache::GetStats() const
+{
+    LOCK(cs);
+    return Stats{mapEntries.size(), nBytes, nMaxBytes, nHits, nMisses};
+}
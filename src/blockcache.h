@@ -0,0 +1,78 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_BLOCKCACHE_H
+#define BITCOIN_BLOCKCACHE_H
+
+#include "primitives/block.h"
+#include "saltedhasher.h"
+#include "sync.h"
+#include "uint256.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/** Default for -maxblockcache, in megabytes */
+static const unsigned int DEFAULT_MAX_BLOCK_CACHE = 16;
+
+/**
+ * Size bounded LRU of recently connected or read blocks, keyed by block hash.
+ * Many subsystems re-read the same recent blocks (AntiGPU, GSC assessment, prayer
+ * memorization, getblock, ZMQ raw block publishing); ReadBlockFromDisk serves those
+ * from here instead of deserializing them again.
+ */
+class CRecentBlockCache
+{
+public:
+    struct Stats
+    {
+        size_t nEntries;
+        size_t nBytes;
+        size_t nMaxBytes;
+        uint64_t nHits;
+        uint64_t nMisses;
+    };
+
+private:
+    struct Entry
+    {
+        uint256 hash;
+        std::shared_ptr<const CBlock> pblock;
+        size_t nSize;
+        //! whether the proof of work of this block was verified when it was inserted
+        bool fCheckedPoW;
+    };
+    typedef std::list<Entry> EntryList;
+
+    mutable CCriticalSection cs;
+    //! most recently used first
+    EntryList listEntries;
+    std::unordered_map<uint256, EntryList::iterator, StaticSaltedHasher> mapEntries;
+    size_t nBytes;
+    size_t nMaxBytes;
+    uint64_t nHits;
+    uint64_t nMisses;
+
+    void Trim();
+
+public:
+    explicit CRecentBlockCache(size_t nMaxBytesIn);
+
+    void SetMaxBytes(size_t nMaxBytesIn);
+
+    /** Remember a block. fCheckedPoW tells whether its proof of work was verified. */
+    void Insert(const uint256& hash, const std::shared_ptr<const CBlock>& pblock, bool fCheckedPoW);
+
+    /** Look up a block, only returning it if its proof of work was verified when fRequirePoW is set */
+    std::shared_ptr<const CBlock> Get(const uint256& hash, bool fRequirePoW);
+
+    void Clear();
+
+    Stats GetStats() const;
+};
+
+extern CRecentBlockCache recentBlockCache;
+
+#endif // BITCOIN_BLOCKCACHE_H
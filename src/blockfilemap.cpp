@@ -0,0 +1,99 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "blockfilemap.h"
+
+#include "util.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CBlockFileMapCache blockFileMapCache(DEFAULT_MAX_MAPPED_BLOCK_FILES);
+
+CMappedBlockFile::~CMappedBlockFile()
+{
+#ifndef WIN32
+    munmap((void*)pdata, nSize);
+#endif
+}
+
+void CBlockFileMapCache::SetMaxFiles(size_t nMaxFilesIn)
+{
+    LOCK(cs);
+    nMaxFiles = nMaxFilesIn;
+    Evict(nMaxFiles);
+}
+
+void CBlockFileMapCache::Evict(size_t nKeep)
+{
+    AssertLockHeld(cs);
+    while (listLRU.size() > nKeep) {
+        mapFiles.erase(listLRU.back());
+        listLRU.pop_back();
+    }
+}
+
+CBlockFileMapCache::MappedFilePtr CBlockFileMapCache::Get(int nFile, const boost::filesystem::path& path, uint64_t nMinSize)
+{
+    LOCK(cs);
+    auto it = mapFiles.find(nFile);
+    if (it != mapFiles.end() && it->second.first->size() >= nMinSize) {
+        listLRU.splice(listLRU.begin(), listLRU, it->second.second);
+        return it->second.first;
+    }
+    if (nMaxFiles == 0)
+        return nullptr;
+
+#ifdef WIN32
+    return nullptr;
+#else
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (it != mapFiles.end() && (uint64_t)st.st_size <= it->second.first->size())) {
+        // Nothing new to map; keep using the existing mapping, if any
+        close(fd);
+        return it != mapFiles.end() ? it->second.first : nullptr;
+    }
+    void* pmap = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pmap == MAP_FAILED) {
+        LogPrintf("%s: mmap of %s failed, reading it through the file instead\n", __func__, path.string());
+        return nullptr;
+    }
+
+    MappedFilePtr pfile = std::make_shared<const CMappedBlockFile>((const unsigned char*)pmap, (size_t)st.st_size);
+    if (it != mapFiles.end()) {
+        // Remapped a grown file; readers holding the old mapping keep it alive until they are done
+        it->second.first = pfile;
+        listLRU.splice(listLRU.begin(), listLRU, it->second.second);
+    } else {
+        listLRU.push_front(nFile);
+        mapFiles.emplace(nFile, std::make_pair(pfile, listLRU.begin()));
+        Evict(nMaxFiles);
+    }
+    return pfile;
+#endif
+}
+
+void CBlockFileMapCache::Release(int nFile)
+{
+    LOCK(cs);
+    auto it = mapFiles.find(nFile);
+    if (it == mapFiles.end())
+        return;
+    listLRU.erase(it->second.second);
+    mapFiles.erase(it);
+}
+
+size_t CBlockFileMapCache::Size() const
+{
+    LOCK(cs);
+    return mapFiles.size();
+}
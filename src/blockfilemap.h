@@ -0,0 +1,78 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_BLOCKFILEMAP_H
+#define BITCOIN_BLOCKFILEMAP_H
+
+#include "sync.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <stdint.h>
+
+#include <boost/filesystem/path.hpp>
+
+/** Default for -maxmappedblockfiles, the number of blk?????.dat files kept memory mapped (0 disables) */
+static const unsigned int DEFAULT_MAX_MAPPED_BLOCK_FILES = sizeof(void*) >= 8 ? 8 : 0;
+
+/** A read-only memory mapping of a whole block file, unmapped when the last user lets go of it */
+class CMappedBlockFile
+{
+private:
+    const unsigned char* pdata;
+    size_t nSize;
+
+    CMappedBlockFile(const CMappedBlockFile&) = delete;
+    CMappedBlockFile& operator=(const CMappedBlockFile&) = delete;
+
+public:
+    CMappedBlockFile(const unsigned char* pdataIn, size_t nSizeIn) : pdata(pdataIn), nSize(nSizeIn) {}
+    ~CMappedBlockFile();
+
+    const unsigned char* data() const { return pdata; }
+    size_t size() const { return nSize; }
+};
+
+/**
+ * Bounded LRU of memory mapped block files. ReadBlockFromDisk deserializes straight
+ * from these mappings, so historical scans (prayer memorization, GSC assessment,
+ * AntiGPU, chain searches) do not pay an fopen/fseek/fread and a buffer copy per block.
+ * A file is mapped up to its current size and remapped once a read needs more than
+ * that, which only happens for the block file currently being appended to.
+ */
+class CBlockFileMapCache
+{
+private:
+    typedef std::shared_ptr<const CMappedBlockFile> MappedFilePtr;
+
+    mutable CCriticalSection cs;
+    size_t nMaxFiles;
+    //! file numbers, most recently used first
+    std::list<int> listLRU;
+    std::map<int, std::pair<MappedFilePtr, std::list<int>::iterator> > mapFiles;
+
+    void Evict(size_t nKeep);
+
+public:
+    explicit CBlockFileMapCache(size_t nMaxFilesIn) : nMaxFiles(nMaxFilesIn) {}
+
+    void SetMaxFiles(size_t nMaxFilesIn);
+
+    /**
+     * Return a mapping of block file nFile at path, covering at least its first nMinSize
+     * bytes when the file is that large. Returns nullptr when mapping is disabled or fails;
+     * callers then fall back to regular file I/O.
+     */
+    MappedFilePtr Get(int nFile, const boost::filesystem::path& path, uint64_t nMinSize);
+
+    /** Forget the mapping of nFile, e.g. before the file is truncated or pruned */
+    void Release(int nFile);
+
+    size_t Size() const;
+};
+
+extern CBlockFileMapCache blockFileMapCache;
+
+#endif // BITCOIN_BLOCKFILEMAP_H
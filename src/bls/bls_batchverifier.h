@@ -6,7 +6,10 @@
 #define DASH_CRYPTO_BLS_BATCHVERIFIER_H
 
 #include "bls.h"
+#include "bls_worker.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -232,4 +235,104 @@ private:
     }
 };
 
+// Splits a batch into shards that are verified in parallel on the BLS worker pool. All messages of one source end up
+// in the same shard, so the per-source and per-message fallbacks of CBLSBatchVerifier keep working unchanged inside
+// each shard and a single bad source only forces re-verification of its own shard.
+template<typename SourceId, typename MessageId>
+class CBLSShardedBatchVerifier
+{
+private:
+    struct Message {
+        MessageId msgId;
+        uint256 msgHash;
+        CBLSSignature sig;
+        CBLSPublicKey pubKey;
+    };
+
+    typedef CBLSBatchVerifier<SourceId, MessageId> Shard;
+
+    bool secureVerification;
+    bool perMessageFallback;
+    size_t maxShards;
+    size_t minShardSize;
+
+    std::map<SourceId, std::vector<Message>> messagesBySource;
+    size_t messageCount{0};
+
+public:
+    std::set<SourceId> badSources;
+    std::set<MessageId> badMessages;
+
+public:
+    // Every shard costs at least one extra pairing, so small batches are not split below minShardSize messages
+    CBLSShardedBatchVerifier(bool _secureVerification, bool _perMessageFallback, size_t _maxShards = 4, size_t _minShardSize = 16) :
+            secureVerification(_secureVerification),
+            perMessageFallback(_perMessageFallback),
+            maxShards(std::max(_maxShards, (size_t)1)),
+            minShardSize(std::max(_minShardSize, (size_t)1))
+    {
+    }
+
+    void PushMessage(const SourceId& sourceId, const MessageId& msgId, const uint256& msgHash, const CBLSSignature& sig, const CBLSPublicKey& pubKey)
+    {
+        assert(sig.IsValid() && pubKey.IsValid());
+
+        messagesBySource[sourceId].emplace_back(Message{msgId, msgHash, sig, pubKey});
+        messageCount++;
+    }
+
+    void ClearMessages()
+    {
+        messagesBySource.clear();
+        messageCount = 0;
+    }
+
+    // Runs the shards on blsWorker, or on the calling thread if none is given
+    void Verify(CBLSWorker* blsWorker)
+    {
+        if (messageCount == 0) {
+            return;
+        }
+
+        size_t shardCount = std::min(maxShards, std::max(messageCount / minShardSize, (size_t)1));
+        shardCount = std::min(shardCount, messagesBySource.size());
+
+        std::vector<Shard> shards;
+        std::vector<size_t> shardSizes(shardCount, 0);
+        shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; i++) {
+            shards.emplace_back(secureVerification, perMessageFallback);
+        }
+
+        // greedily put each source into the currently smallest shard
+        for (const auto& p : messagesBySource) {
+            size_t idx = std::min_element(shardSizes.begin(), shardSizes.end()) - shardSizes.begin();
+            for (const auto& msg : p.second) {
+                shards[idx].PushMessage(p.first, msg.msgId, msg.msgHash, msg.sig, msg.pubKey);
+            }
+            shardSizes[idx] += p.second.size();
+        }
+
+        std::vector<std::function<void()>> jobs;
+        jobs.reserve(shardCount);
+        for (auto& shard : shards) {
+            jobs.emplace_back([&shard]() {
+                shard.Verify();
+            });
+        }
+        if (blsWorker) {
+            blsWorker->RunJobs(jobs);
+        } else {
+            for (const auto& job : jobs) {
+                job();
+            }
+        }
+
+        for (const auto& shard : shards) {
+            badSources.insert(shard.badSources.begin(), shard.badSources.end());
+            badMessages.insert(shard.badMessages.begin(), shard.badMessages.end());
+        }
+    }
+};
+
 #endif //DASH_CRYPTO_BLS_BATCHVERIFIER_H
@@ -72,6 +72,33 @@ void CBLSWorker::Stop()
     workerPool.stop(true);
 }
 
+void CBLSWorker::RunJobs(const std::vector<std::function<void()> >& jobs)
+{
+    if (jobs.empty()) {
+        return;
+    }
+    if (workerPool.size() == 0 || jobs.size() == 1) {
+        for (const auto& job : jobs) {
+            job();
+        }
+        return;
+    }
+
+    std::vector<std::future<void> > futures;
+    futures.reserve(jobs.size() - 1);
+    for (size_t i = 1; i < jobs.size(); i++) {
+        const auto& job = jobs[i];
+        futures.emplace_back(workerPool.push([&job](int threadId) {
+            job();
+        }));
+    }
+    // the calling thread would only wait otherwise, so let it do the first job
+    jobs[0]();
+    for (auto& f : futures) {
+        f.get();
+    }
+}
+
 bool CBLSWorker::GenerateContributions(int quorumThreshold, const BLSIdVector& ids, BLSVerificationVectorPtr& vvecRet, BLSSecretKeyVector& skShares)
 {
     BLSSecretKeyVectorPtr svec = std::make_shared<BLSSecretKeyVector>((size_t)quorumThreshold);
@@ -56,6 +56,11 @@ public:
     void Start();
     void Stop();
 
+    // Runs all jobs in parallel on the worker pool and the calling thread and returns when all of them are done
+    // Falls back to running them one after another on the calling thread when the pool was not started
+    // Jobs must not wait for other work on the worker pool, as all workers might be busy with jobs then
+    void RunJobs(const std::vector<std::function<void()> >& jobs);
+
     bool GenerateContributions(int threshold, const BLSIdVector& ids, BLSVerificationVectorPtr& vvecRet, BLSSecretKeyVector& skShares);
 
     // The following functions are all used to aggregate verification (public key) vectors
@@ -28,6 +28,13 @@ static const int64_t MAX_FUTURE_BLOCK_TIME = 2 * 60 * 60;
  */
 static const int64_t TIMESTAMP_WINDOW = MAX_FUTURE_BLOCK_TIME;
 
+/**
+ * Block index records written by this client version or later store the
+ * RandomX proof in CRandomXHeader's compact binary form instead of the
+ * "<rxheader>" wrapped hex string. Older records are still read as strings.
+ */
+static const int DISK_BLOCK_INDEX_RX_COMPACT_VERSION = 1050008;
+
 class CBlockFileInfo
 {
 public:
@@ -213,7 +220,7 @@ public:
     unsigned int nBits;
     unsigned int nNonce;
 	uint256 RandomXKey;
-	std::string RandomXData;
+	CRandomXHeader RandomXHeader;
 
     //! (memory only) Sequential id assigned to distinguish order in which blocks are received.
     int32_t nSequenceId;
@@ -242,7 +249,7 @@ public:
         nTime          = 0;
         nBits          = 0;
         nNonce         = 0;
-		RandomXData    = std::string();
+		RandomXHeader  = CRandomXHeader();
     }
 
     CBlockIndex()
@@ -260,7 +267,7 @@ public:
         nBits          = block.nBits;
         nNonce         = block.nNonce;
 		RandomXKey     = block.RandomXKey;
-	    RandomXData    = block.RandomXData;
+		RandomXHeader  = block.GetRandomXHeader();
     }
 
     CDiskBlockPos GetBlockPos() const {
@@ -292,7 +299,7 @@ public:
         block.nBits          = nBits;
         block.nNonce         = nNonce;
 		block.RandomXKey     = RandomXKey;
-		block.RandomXData    = RandomXData;
+		block.RandomXData    = RandomXHeader.ToString();
 
         return block;
     }
@@ -416,7 +423,16 @@ public:
         READWRITE(nBits);
         READWRITE(nNonce);
 		READWRITE(RandomXKey);
-		READWRITE(LIMITED_STRING(RandomXData, 2000));
+		if (_nVersion >= DISK_BLOCK_INDEX_RX_COMPACT_VERSION) {
+			READWRITE(RandomXHeader);
+		} else {
+			std::string strRandomXData;
+			if (!ser_action.ForRead())
+				strRandomXData = RandomXHeader.ToString();
+			READWRITE(LIMITED_STRING(strRandomXData, 2000));
+			if (ser_action.ForRead())
+				RandomXHeader = CRandomXHeader::FromString(strRandomXData);
+		}
     }
 
     uint256 GetBlockHash() const
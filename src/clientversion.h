@@ -17,7 +17,7 @@
 #define CLIENT_VERSION_MAJOR 1
 #define CLIENT_VERSION_MINOR 5
 #define CLIENT_VERSION_REVISION 0
-#define CLIENT_VERSION_BUILD 7
+#define CLIENT_VERSION_BUILD 8
 
 //! Set to true for release, false for prerelease or test build
 #define CLIENT_VERSION_IS_RELEASE true
@@ -12,7 +12,7 @@
 #include "primitives/block.h"
 #include "uint256.h"
 
-uint256 ComputeMerkleRoot(const std::vector<uint256>& leaves, bool* mutated = NULL);
+uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated = NULL);
 std::vector<uint256> ComputeMerkleBranch(const std::vector<uint256>& leaves, uint32_t position);
 uint256 ComputeMerkleRootFromBranch(const uint256& leaf, const std::vector<uint256>& branch, uint32_t position);
 
@@ -29,4 +29,11 @@ uint256 BlockMerkleRoot(const CBlock& block, bool* mutated = NULL);
  */
 std::vector<uint256> BlockMerkleBranch(const CBlock& block, uint32_t position);
 
+/*
+ * Compute the Merkle root of a block from its coinbase and the coinbase branch
+ * (BlockMerkleBranch(block, 0)), which only depends on the other transactions.
+ * Lets a miner update the root after changing just the coinbase, e.g. the extranonce.
+ */
+uint256 BlockMerkleRootFromCoinbaseBranch(const CBlock& block, const std::vector<uint256>& vCoinbaseBranch);
+
 #endif
@@ -0,0 +1,132 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "crypto/x11.h"
+
+#include "crypto/sph_cubehash.h"
+#include "crypto/sph_echo.h"
+#include "crypto/sph_shavite.h"
+
+#include <assert.h>
+#include <string.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config/coin-config.h"
+#endif
+
+#if defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
+#if defined(HAVE_GETCPUID)
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(ENABLE_X11_X86)
+namespace x11_x86
+{
+void CubeHash512_64(const unsigned char* in, unsigned char* out);
+void Shavite512_64(const unsigned char* in, unsigned char* out);
+void Echo512_64(const unsigned char* in, unsigned char* out);
+}
+#endif
+
+namespace
+{
+/// Portable implementations on top of the sph code.
+namespace x11
+{
+void CubeHash512_64(const unsigned char* in, unsigned char* out)
+{
+    sph_cubehash512_context ctx;
+    sph_cubehash512_init(&ctx);
+    sph_cubehash512(&ctx, in, 64);
+    sph_cubehash512_close(&ctx, out);
+}
+
+void Shavite512_64(const unsigned char* in, unsigned char* out)
+{
+    sph_shavite512_context ctx;
+    sph_shavite512_init(&ctx);
+    sph_shavite512(&ctx, in, 64);
+    sph_shavite512_close(&ctx, out);
+}
+
+void Echo512_64(const unsigned char* in, unsigned char* out)
+{
+    sph_echo512_context ctx;
+    sph_echo512_init(&ctx);
+    sph_echo512(&ctx, in, 64);
+    sph_echo512_close(&ctx, out);
+}
+
+typedef void (*StageType)(const unsigned char*, unsigned char*);
+} // namespace x11
+
+x11::StageType CubeHash = x11::CubeHash512_64;
+x11::StageType Shavite = x11::Shavite512_64;
+x11::StageType Echo = x11::Echo512_64;
+
+/** Compare the selected stages against the portable code on a few inputs. */
+bool SelfTest()
+{
+    unsigned char in[64], out1[64], out2[64];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 64; j++)
+            in[j] = (unsigned char)(i * 97 + j * 13);
+        CubeHash(in, out1);
+        x11::CubeHash512_64(in, out2);
+        if (memcmp(out1, out2, 64) != 0) return false;
+        Shavite(in, out1);
+        x11::Shavite512_64(in, out2);
+        if (memcmp(out1, out2, 64) != 0) return false;
+        Echo(in, out1);
+        x11::Echo512_64(in, out2);
+        if (memcmp(out1, out2, 64) != 0) return false;
+    }
+    return true;
+}
+} // namespace
+
+std::string X11AutoDetect(bool fUseOptimized)
+{
+    std::string ret = "standard";
+    CubeHash = x11::CubeHash512_64;
+    Shavite = x11::Shavite512_64;
+    Echo = x11::Echo512_64;
+
+#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__)) && defined(HAVE_GETCPUID) && defined(ENABLE_X11_X86)
+    uint32_t eax, ebx, ecx, edx;
+    if (fUseOptimized && __get_cpuid_max(0, nullptr) >= 1) {
+        __cpuid(1, eax, ebx, ecx, edx);
+        bool have_ssse3 = (ecx >> 9) & 1;
+        bool have_aesni = (ecx >> 25) & 1;
+        if (have_ssse3) {
+            CubeHash = x11_x86::CubeHash512_64;
+            ret = "cubehash(sse2)";
+            if (have_aesni) {
+                Shavite = x11_x86::Shavite512_64;
+                Echo = x11_x86::Echo512_64;
+                ret += ",shavite(aesni),echo(aesni)";
+            }
+        }
+    }
+#endif
+
+    assert(SelfTest());
+    return ret;
+}
+
+void X11CubeHash512_64(const unsigned char* in, unsigned char* out)
+{
+    CubeHash(in, out);
+}
+
+void X11Shavite512_64(const unsigned char* in, unsigned char* out)
+{
+    Shavite(in, out);
+}
+
+void X11Echo512_64(const unsigned char* in, unsigned char* out)
+{
+    Echo(in, out);
+}
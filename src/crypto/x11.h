@@ -0,0 +1,25 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_CRYPTO_X11_H
+#define BITCOIN_CRYPTO_X11_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+/** Autodetect the best available implementations of the X11 stages below.
+ *  With fUseOptimized false the portable sph code is selected.
+ *  Returns a description of the selected implementations.
+ */
+std::string X11AutoDetect(bool fUseOptimized = true);
+
+/** The X11 stages that have optimized versions. All of them hash exactly 64 bytes
+ *  into a 64-byte digest, which is what every stage after the first one sees.
+ */
+void X11CubeHash512_64(const unsigned char* in, unsigned char* out);
+void X11Shavite512_64(const unsigned char* in, unsigned char* out);
+void X11Echo512_64(const unsigned char* in, unsigned char* out);
+
+#endif // BITCOIN_CRYPTO_X11_H
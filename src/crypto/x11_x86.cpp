@@ -0,0 +1,272 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// SIMD versions of the CubeHash-512, SHAvite-512 and ECHO-512 stages of X11.
+// These stages only ever see the 64-byte output of the previous stage, so the
+// padding is fixed and the code is specialised for that length.
+// This file is compiled with -maes -mssse3 and only called after CPUID detection.
+
+#ifdef ENABLE_X11_X86
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+namespace {
+
+const uint32_t CUBEHASH512_IV[32] = {
+    0x2AEA2A61, 0x50F494D4, 0x2D538B8B, 0x4167D83E,
+    0x3FEE2313, 0xC701CF8C, 0xCC39968E, 0x50AC5695,
+    0x4D42C787, 0xA647A8B3, 0x97CF0BEF, 0x825B4537,
+    0xEEF864D2, 0xF22090C4, 0xD0E5CD33, 0xA23911AE,
+    0xFCD398D9, 0x148FE485, 0x1B017BEF, 0xB6444532,
+    0x6A536159, 0x2FF5781C, 0x91FA7934, 0x0DBADEA9,
+    0xD65C8A2B, 0xA5A70E75, 0xB1C62456, 0xBC796576,
+    0x1921C8F7, 0xE7989AF1, 0x7795D246, 0xD43E3B44
+};
+
+const uint32_t SHAVITE512_IV[16] = {
+    0x72FCCDD8, 0x79CA4727, 0x128A077B, 0x40D55AEC,
+    0xD1901A06, 0x430AE307, 0xB29F5CD1, 0xDF07FBFC,
+    0x8E45D73D, 0x681AB538, 0xBDE86578, 0xDD577E47,
+    0xE275EADE, 0x502D9FCD, 0xB9357178, 0x022A4B9A
+};
+
+/** One keyless AES round, as used by both SHAvite-3 and ECHO. */
+__m128i inline AESRound(__m128i x)
+{
+    return _mm_aesenc_si128(x, _mm_setzero_si128());
+}
+
+/** Double every byte in GF(2^8) with the AES polynomial. */
+__m128i inline XTime(__m128i x)
+{
+    const __m128i carry = _mm_and_si128(_mm_cmplt_epi8(x, _mm_setzero_si128()), _mm_set1_epi8(0x1b));
+    return _mm_xor_si128(_mm_add_epi8(x, x), carry);
+}
+
+template<int n>
+__m128i inline RotL(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n));
+}
+
+/** CubeHash rounds; x0..x3 hold state words 0-15 and y0..y3 words 16-31. */
+void inline CubeHashRounds(__m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3,
+                           __m128i& y0, __m128i& y1, __m128i& y2, __m128i& y3, int rounds)
+{
+    for (int r = 0; r < rounds; r++) {
+        y0 = _mm_add_epi32(y0, x0);
+        y1 = _mm_add_epi32(y1, x1);
+        y2 = _mm_add_epi32(y2, x2);
+        y3 = _mm_add_epi32(y3, x3);
+        // Rotate by 7, swapping words 0-7 with 8-15
+        __m128i t0 = RotL<7>(x2);
+        __m128i t1 = RotL<7>(x3);
+        __m128i t2 = RotL<7>(x0);
+        __m128i t3 = RotL<7>(x1);
+        x0 = _mm_xor_si128(t0, y0);
+        x1 = _mm_xor_si128(t1, y1);
+        x2 = _mm_xor_si128(t2, y2);
+        x3 = _mm_xor_si128(t3, y3);
+        y0 = _mm_add_epi32(_mm_shuffle_epi32(y0, 0x4e), x0);
+        y1 = _mm_add_epi32(_mm_shuffle_epi32(y1, 0x4e), x1);
+        y2 = _mm_add_epi32(_mm_shuffle_epi32(y2, 0x4e), x2);
+        y3 = _mm_add_epi32(_mm_shuffle_epi32(y3, 0x4e), x3);
+        // Rotate by 11, swapping words 0-3 with 4-7 and 8-11 with 12-15
+        t0 = RotL<11>(x1);
+        t1 = RotL<11>(x0);
+        t2 = RotL<11>(x3);
+        t3 = RotL<11>(x2);
+        x0 = _mm_xor_si128(t0, y0);
+        x1 = _mm_xor_si128(t1, y1);
+        x2 = _mm_xor_si128(t2, y2);
+        x3 = _mm_xor_si128(t3, y3);
+        y0 = _mm_shuffle_epi32(y0, 0xb1);
+        y1 = _mm_shuffle_epi32(y1, 0xb1);
+        y2 = _mm_shuffle_epi32(y2, 0xb1);
+        y3 = _mm_shuffle_epi32(y3, 0xb1);
+    }
+}
+
+} // namespace
+
+namespace x11_x86 {
+
+void CubeHash512_64(const unsigned char* in, unsigned char* out)
+{
+    __m128i x0 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 0));
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 4));
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 8));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 12));
+    __m128i y0 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 16));
+    __m128i y1 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 20));
+    __m128i y2 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 24));
+    __m128i y3 = _mm_loadu_si128((const __m128i*)(CUBEHASH512_IV + 28));
+
+    // Two 32-byte message blocks
+    for (int i = 0; i < 2; i++) {
+        x0 = _mm_xor_si128(x0, _mm_loadu_si128((const __m128i*)(in + 32 * i)));
+        x1 = _mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)(in + 32 * i + 16)));
+        CubeHashRounds(x0, x1, x2, x3, y0, y1, y2, y3, 16);
+    }
+
+    // Padding block, then finalization with the last state word flipped
+    x0 = _mm_xor_si128(x0, _mm_set_epi32(0, 0, 0, 0x80));
+    CubeHashRounds(x0, x1, x2, x3, y0, y1, y2, y3, 16);
+    y3 = _mm_xor_si128(y3, _mm_set_epi32(1, 0, 0, 0));
+    CubeHashRounds(x0, x1, x2, x3, y0, y1, y2, y3, 160);
+
+    _mm_storeu_si128((__m128i*)(out + 0), x0);
+    _mm_storeu_si128((__m128i*)(out + 16), x1);
+    _mm_storeu_si128((__m128i*)(out + 32), x2);
+    _mm_storeu_si128((__m128i*)(out + 48), x3);
+}
+
+void Shavite512_64(const unsigned char* in, unsigned char* out)
+{
+    // 64 message bytes, the 0x80 padding byte, the 512 bit counter at byte 110 and the
+    // 512 bit digest size at byte 126.
+    unsigned char block[128] = {0};
+    memcpy(block, in, 64);
+    block[64] = 0x80;
+    block[111] = 0x02;
+    block[127] = 0x02;
+
+    // Key schedule, four 32-bit words per entry. The counter words are (512, 0, 0, 0).
+    __m128i rk[112];
+    for (int i = 0; i < 8; i++)
+        rk[i] = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+
+    const __m128i cnt8 = _mm_set_epi32(~0, 0, 0, 512);
+    const __m128i cnt41 = _mm_set_epi32(~512, 0, 0, 0);
+    const __m128i cnt79 = _mm_set_epi32(~0, 512, 0, 0);
+    const __m128i cnt110 = _mm_set_epi32(~0, 0, 512, 0);
+
+    int g = 8;
+    for (;;) {
+        for (int s = 0; s < 8; s++) {
+            __m128i x = AESRound(_mm_shuffle_epi32(rk[g - 8], 0x39));
+            rk[g] = _mm_xor_si128(x, rk[g - 1]);
+            if (g == 8) {
+                rk[g] = _mm_xor_si128(rk[g], cnt8);
+            } else if (g == 41) {
+                rk[g] = _mm_xor_si128(rk[g], cnt41);
+            } else if (g == 79) {
+                rk[g] = _mm_xor_si128(rk[g], cnt79);
+            } else if (g == 110) {
+                rk[g] = _mm_xor_si128(rk[g], cnt110);
+            }
+            g++;
+        }
+        if (g == 112)
+            break;
+        for (int s = 0; s < 8; s++) {
+            rk[g] = _mm_xor_si128(rk[g - 8], _mm_alignr_epi8(rk[g - 1], rk[g - 2], 4));
+            g++;
+        }
+    }
+
+    const __m128i h0 = _mm_loadu_si128((const __m128i*)(SHAVITE512_IV + 0));
+    const __m128i h1 = _mm_loadu_si128((const __m128i*)(SHAVITE512_IV + 4));
+    const __m128i h2 = _mm_loadu_si128((const __m128i*)(SHAVITE512_IV + 8));
+    const __m128i h3 = _mm_loadu_si128((const __m128i*)(SHAVITE512_IV + 12));
+    __m128i p0 = h0, p1 = h1, p2 = h2, p3 = h3;
+
+    const __m128i* k = rk;
+    for (int r = 0; r < 14; r++) {
+        __m128i x = AESRound(_mm_xor_si128(p1, k[0]));
+        x = AESRound(_mm_xor_si128(x, k[1]));
+        x = AESRound(_mm_xor_si128(x, k[2]));
+        x = AESRound(_mm_xor_si128(x, k[3]));
+        p0 = _mm_xor_si128(p0, x);
+
+        x = AESRound(_mm_xor_si128(p3, k[4]));
+        x = AESRound(_mm_xor_si128(x, k[5]));
+        x = AESRound(_mm_xor_si128(x, k[6]));
+        x = AESRound(_mm_xor_si128(x, k[7]));
+        p2 = _mm_xor_si128(p2, x);
+        k += 8;
+
+        __m128i t = p3;
+        p3 = p2;
+        p2 = p1;
+        p1 = p0;
+        p0 = t;
+    }
+
+    _mm_storeu_si128((__m128i*)(out + 0), _mm_xor_si128(h0, p0));
+    _mm_storeu_si128((__m128i*)(out + 16), _mm_xor_si128(h1, p1));
+    _mm_storeu_si128((__m128i*)(out + 32), _mm_xor_si128(h2, p2));
+    _mm_storeu_si128((__m128i*)(out + 48), _mm_xor_si128(h3, p3));
+}
+
+void Echo512_64(const unsigned char* in, unsigned char* out)
+{
+    // The chaining value is eight copies of the 512 bit digest size, followed by one message
+    // block holding 64 message bytes, the 0x80 padding byte, the digest size at byte 110 and the
+    // 512 bit counter at byte 112.
+    unsigned char block[128] = {0};
+    memcpy(block, in, 64);
+    block[64] = 0x80;
+    block[111] = 0x02;
+    block[113] = 0x02;
+
+    __m128i w[16];
+    const __m128i iv = _mm_set_epi32(0, 0, 0, 512);
+    for (int i = 0; i < 8; i++)
+        w[i] = iv;
+    for (int i = 0; i < 8; i++)
+        w[8 + i] = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+
+    uint32_t counter = 512;
+    for (int r = 0; r < 10; r++) {
+        // BigSubWords: two AES rounds per word, keyed by the running counter and the zero salt
+        for (int i = 0; i < 16; i++)
+            w[i] = AESRound(_mm_aesenc_si128(w[i], _mm_set_epi32(0, 0, 0, counter++)));
+
+        // BigShiftRows
+        __m128i t = w[1];
+        w[1] = w[5];
+        w[5] = w[9];
+        w[9] = w[13];
+        w[13] = t;
+        t = w[2];
+        w[2] = w[10];
+        w[10] = t;
+        t = w[6];
+        w[6] = w[14];
+        w[14] = t;
+        t = w[15];
+        w[15] = w[11];
+        w[11] = w[7];
+        w[7] = w[3];
+        w[3] = t;
+
+        // BigMixColumns
+        for (int c = 0; c < 16; c += 4) {
+            const __m128i a = w[c], b = w[c + 1], cc = w[c + 2], d = w[c + 3];
+            const __m128i ab = _mm_xor_si128(a, b);
+            const __m128i bc = _mm_xor_si128(b, cc);
+            const __m128i cd = _mm_xor_si128(cc, d);
+            const __m128i abx = XTime(ab);
+            const __m128i bcx = XTime(bc);
+            const __m128i cdx = XTime(cd);
+            w[c] = _mm_xor_si128(abx, _mm_xor_si128(bc, d));
+            w[c + 1] = _mm_xor_si128(bcx, _mm_xor_si128(a, cd));
+            w[c + 2] = _mm_xor_si128(cdx, _mm_xor_si128(ab, d));
+            w[c + 3] = _mm_xor_si128(_mm_xor_si128(abx, bcx), _mm_xor_si128(_mm_xor_si128(cdx, ab), cc));
+        }
+    }
+
+    // BigFinal, keeping the first four words of the chaining value
+    for (int i = 0; i < 4; i++) {
+        const __m128i m = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+        _mm_storeu_si128((__m128i*)(out + 16 * i), _mm_xor_si128(_mm_xor_si128(iv, m), _mm_xor_si128(w[i], w[i + 8])));
+    }
+}
+
+} // namespace x11_x86
+
+#endif // ENABLE_X11_X86
@@ -73,13 +73,53 @@ public:
     }
 };
 
-static leveldb::Options GetOptions(size_t nCacheSize)
+/**
+ * Look up a database tuning option. Plain values apply to every database,
+ * "<name>:<value>" applies to the database named <name> only and takes
+ * precedence over a plain value.
+ */
+static std::string GetDBArg(const std::string& strArg, const std::string& strName, const std::string& strDefault)
+{
+    std::string strGlobal = strDefault;
+    std::string strScoped;
+    auto it = mapMultiArgs.find(strArg);
+    if (it == mapMultiArgs.end())
+        return strDefault;
+    for (const std::string& strEntry : it->second) {
+        size_t nPos = strEntry.find(':');
+        if (nPos == std::string::npos) {
+            strGlobal = strEntry;
+        } else if (!strName.empty() && strEntry.compare(0, nPos, strName) == 0) {
+            strScoped = strEntry.substr(nPos + 1);
+        }
+    }
+    return strScoped.empty() ? strGlobal : strScoped;
+}
+
+static leveldb::Options GetOptions(size_t nCacheSize, const std::string& strName)
 {
     leveldb::Options options;
     options.block_cache = leveldb::NewLRUCache(nCacheSize / 2);
     options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
-    options.filter_policy = leveldb::NewBloomFilterPolicy(10);
+
+    int nBloomBits = std::max(0, atoi(GetDBArg("-dbbloombits", strName, std::to_string(DEFAULT_DB_BLOOM_BITS))));
+    options.filter_policy = nBloomBits > 0 ? leveldb::NewBloomFilterPolicy(nBloomBits) : NULL;
+
+    int nBlockSize = atoi(GetDBArg("-dbblocksize", strName, std::to_string(DEFAULT_DB_BLOCK_SIZE)));
+    options.block_size = std::min(std::max(nBlockSize, 1), 1024) * 1024;
+
     options.compression = leveldb::kNoCompression;
+    std::string strCompression = GetDBArg("-dbcompression", strName, DEFAULT_DB_COMPRESSION);
+    if (strCompression == "snappy") {
+#ifdef USE_SNAPPY
+        options.compression = leveldb::kSnappyCompression;
+#else
+        LogPrintf("%s: LevelDB was built without Snappy support, not compressing %s\n", __func__, strName);
+#endif
+    } else if (strCompression != "none") {
+        LogPrintf("%s: unknown -dbcompression value \"%s\" for %s, not compressing\n", __func__, strCompression, strName);
+    }
+
     options.max_open_files = 64;
     options.info_log = new CBitcoinLevelDBLogger();
     if (leveldb::kMajorVersion > 1 || (leveldb::kMajorVersion == 1 && leveldb::kMinorVersion >= 16)) {
@@ -97,7 +137,8 @@ CDBWrapper::CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, b
     iteroptions.verify_checksums = true;
     iteroptions.fill_cache = false;
     syncoptions.sync = true;
-    options = GetOptions(nCacheSize);
+    std::string strName = path.filename().string();
+    options = GetOptions(nCacheSize, strName);
     options.create_if_missing = true;
     if (fMemory) {
         penv = leveldb::NewMemEnv(leveldb::Env::Default());
@@ -109,7 +150,9 @@ CDBWrapper::CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, b
             dbwrapper_private::HandleError(result);
         }
         TryCreateDirectory(path);
-        LogPrintf("Opening LevelDB in %s\n", path.string());
+        LogPrintf("Opening LevelDB in %s (compression=%s, block size=%u, bloom filter=%s)\n", path.string(),
+            options.compression == leveldb::kSnappyCompression ? "snappy" : "none", options.block_size,
+            options.filter_policy ? options.filter_policy->Name() : "none");
     }
     leveldb::Status status = leveldb::DB::Open(options, path.string(), &pdb);
     dbwrapper_private::HandleError(status);
@@ -22,6 +22,13 @@
 static const size_t DBWRAPPER_PREALLOC_KEY_SIZE = 64;
 static const size_t DBWRAPPER_PREALLOC_VALUE_SIZE = 1024;
 
+//! -dbcompression default: no compression
+static const char* const DEFAULT_DB_COMPRESSION = "none";
+//! -dbblocksize default, in KiB (leveldb's own default)
+static const int DEFAULT_DB_BLOCK_SIZE = 4;
+//! -dbbloombits default: bits per key of the bloom filter policy, 0 to disable
+static const int DEFAULT_DB_BLOOM_BITS = 10;
+
 class dbwrapper_error : public std::runtime_error
 {
 public:
@@ -239,6 +246,10 @@ public:
      * @param[in] fWipe       If true, remove all existing data.
      * @param[in] obfuscate   If true, store data obfuscated via simple XOR. If false, XOR
      *                        with a zero'd byte array.
+     *
+     * Compression, block size and bloom filter settings are taken from -dbcompression,
+     * -dbblocksize and -dbbloombits, which may be scoped to this database by prefixing
+     * the value with the last path component (e.g. -dbcompression=index:snappy).
      */
     CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false);
     ~CDBWrapper();
@@ -203,54 +203,47 @@ static int CompareByLastPaid_GetHeight(const CDeterministicMN& dmn)
     return height;
 }
 
-static bool CompareByLastPaid(const CDeterministicMN& _a, const CDeterministicMN& _b)
+// Ordering by (height, proTxHash) is the same as the old CompareByLastPaid
+static CDeterministicMNList::PaymentQueueEntry MakePaymentQueueEntry(const CDeterministicMN& dmn)
 {
-    int ah = CompareByLastPaid_GetHeight(_a);
-    int bh = CompareByLastPaid_GetHeight(_b);
-    if (ah == bh) {
-        return _a.proTxHash < _b.proTxHash;
-    } else {
-        return ah < bh;
-    }
+    return std::make_pair(CompareByLastPaid_GetHeight(dmn), dmn.proTxHash);
+}
+
+void CDeterministicMNList::AddToPaymentQueue(const CDeterministicMNCPtr& dmn)
+{
+    auto entry = MakePaymentQueueEntry(*dmn);
+    auto it = std::lower_bound(mnPaymentQueue.begin(), mnPaymentQueue.end(), entry);
+    assert(it == mnPaymentQueue.end() || *it != entry);
+    mnPaymentQueue = mnPaymentQueue.insert(it - mnPaymentQueue.begin(), entry);
 }
-static bool CompareByLastPaid(const CDeterministicMNCPtr& _a, const CDeterministicMNCPtr& _b)
+
+void CDeterministicMNList::RemoveFromPaymentQueue(const CDeterministicMNCPtr& dmn)
 {
-    return CompareByLastPaid(*_a, *_b);
+    auto entry = MakePaymentQueueEntry(*dmn);
+    auto it = std::lower_bound(mnPaymentQueue.begin(), mnPaymentQueue.end(), entry);
+    assert(it != mnPaymentQueue.end() && *it == entry);
+    mnPaymentQueue = mnPaymentQueue.erase(it - mnPaymentQueue.begin());
 }
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNPayee() const
 {
-    if (mnMap.size() == 0) {
+    if (mnPaymentQueue.empty()) {
         return nullptr;
     }
-
-    CDeterministicMNCPtr best;
-    ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
-        if (!best || CompareByLastPaid(dmn, best)) {
-            best = dmn;
-        }
-    });
-
-    return best;
+    return GetMN(mnPaymentQueue.front().second);
 }
 
 std::vector<CDeterministicMNCPtr> CDeterministicMNList::GetProjectedMNPayees(int nCount) const
 {
-    if (nCount > GetValidMNsCount()) {
-        nCount = GetValidMNsCount();
+    if (nCount > (int)mnPaymentQueue.size()) {
+        nCount = mnPaymentQueue.size();
     }
 
     std::vector<CDeterministicMNCPtr> result;
     result.reserve(nCount);
-
-    ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
-        result.emplace_back(dmn);
-    });
-    std::sort(result.begin(), result.end(), [&](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
-        return CompareByLastPaid(a, b);
-    });
-
-    result.resize(nCount);
+    for (const auto& entry : mnPaymentQueue.take(nCount)) {
+        result.emplace_back(GetMN(entry.second));
+    }
 
     return result;
 }
@@ -452,6 +445,9 @@ void CDeterministicMNList::AddMN(const CDeterministicMNCPtr& dmn)
     if (dmn->pdmnState->pubKeyOperator.Get().IsValid()) {
         AddUniqueProperty(dmn, dmn->pdmnState->pubKeyOperator);
     }
+    if (IsMNValid(dmn)) {
+        AddToPaymentQueue(dmn);
+    }
 }
 
 void CDeterministicMNList::UpdateMN(const CDeterministicMNCPtr& oldDmn, const CDeterministicMNStateCPtr& pdmnState)
@@ -462,6 +458,18 @@ void CDeterministicMNList::UpdateMN(const CDeterministicMNCPtr& oldDmn, const CD
     dmn->pdmnState = pdmnState;
     mnMap = mnMap.set(oldDmn->proTxHash, dmn);
 
+    // Only re-sort when the payment position or validity changed (e.g. not on PoSe penalty changes)
+    bool fWasValid = IsMNValid(oldDmn);
+    bool fIsValid = IsMNValid(dmn);
+    if (fWasValid != fIsValid || (fIsValid && MakePaymentQueueEntry(*oldDmn) != MakePaymentQueueEntry(*dmn))) {
+        if (fWasValid) {
+            RemoveFromPaymentQueue(oldDmn);
+        }
+        if (fIsValid) {
+            AddToPaymentQueue(dmn);
+        }
+    }
+
     UpdateUniqueProperty(dmn, oldState->addr, pdmnState->addr);
     UpdateUniqueProperty(dmn, oldState->keyIDOwner, pdmnState->keyIDOwner);
     UpdateUniqueProperty(dmn, oldState->pubKeyOperator, pdmnState->pubKeyOperator);
@@ -495,6 +503,9 @@ void CDeterministicMNList::RemoveMN(const uint256& proTxHash)
     if (dmn->pdmnState->pubKeyOperator.Get().IsValid()) {
         DeleteUniqueProperty(dmn, dmn->pdmnState->pubKeyOperator);
     }
+    if (IsMNValid(dmn)) {
+        RemoveFromPaymentQueue(dmn);
+    }
     mnMap = mnMap.erase(proTxHash);
     mnInternalIdMap = mnInternalIdMap.erase(dmn->internalId);
 }
@@ -562,9 +573,6 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
         LogPrintf("CDeterministicMNManager::%s -- DIP3 is enforced now. nHeight=%d\n", __func__, nHeight);
     }
 
-    LOCK(cs);
-    CleanupCache(nHeight);
-
     return true;
 }
 
@@ -891,28 +899,33 @@ void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList
 
 CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex* pindex)
 {
-    LOCK(cs);
-
     CDeterministicMNList snapshot;
     std::list<std::pair<const CBlockIndex*, CDeterministicMNListDiff>> listDiff;
+    int nTipHeight;
+    {
+        LOCK(cs);
+        nTipHeight = tipIndex ? tipIndex->nHeight : pindex->nHeight;
+    }
 
+    // Walk back to the closest cached list or snapshot (written every SNAPSHOT_LIST_PERIOD
+    // blocks). Only the cache needs cs, evoDb synchronizes its own reads.
+    bool fCached = false;
     while (true) {
-        // try using cache before reading from disk
-        auto it = mnListsCache.find(pindex->GetBlockHash());
-        if (it != mnListsCache.end()) {
-            snapshot = it->second;
-            break;
+        {
+            LOCK(cs);
+            if (mnListsCache.get(pindex->GetBlockHash(), snapshot)) {
+                fCached = true;
+                break;
+            }
         }
 
         if (evoDb.Read(std::make_pair(DB_LIST_SNAPSHOT, pindex->GetBlockHash()), snapshot)) {
-            mnListsCache.emplace(pindex->GetBlockHash(), snapshot);
             break;
         }
 
         CDeterministicMNListDiff diff;
         if (!evoDb.Read(std::make_pair(DB_LIST_DIFF, pindex->GetBlockHash()), diff)) {
             snapshot = CDeterministicMNList(pindex->GetBlockHash(), -1, 0);
-            mnListsCache.emplace(pindex->GetBlockHash(), snapshot);
             break;
         }
 
@@ -920,9 +933,16 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
         pindex = pindex->pprev;
     }
 
-    for (const auto& p : listDiff) {
-        auto diffIndex = p.first;
-        auto& diff = p.second;
+    // Lists near the tip are needed again by the next blocks. Of older ones (protx list/diff
+    // at some height) only keep the requested one, so such queries don't flush the cache.
+    std::vector<std::pair<uint256, CDeterministicMNList>> vToCache;
+    if (!fCached && (listDiff.empty() || pindex->nHeight + LISTS_CACHE_SIZE >= nTipHeight)) {
+        vToCache.emplace_back(pindex->GetBlockHash(), snapshot);
+    }
+
+    for (auto it = listDiff.begin(); it != listDiff.end(); ++it) {
+        auto diffIndex = it->first;
+        auto& diff = it->second;
         if (diff.HasChanges()) {
             snapshot = snapshot.ApplyDiff(diffIndex, diff);
         } else {
@@ -930,7 +950,16 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
             snapshot.SetHeight(diffIndex->nHeight);
         }
 
-        mnListsCache.emplace(diffIndex->GetBlockHash(), snapshot);
+        if (diffIndex->nHeight + LISTS_CACHE_SIZE >= nTipHeight || std::next(it) == listDiff.end()) {
+            vToCache.emplace_back(diffIndex->GetBlockHash(), snapshot);
+        }
+    }
+
+    if (!vToCache.empty()) {
+        LOCK(cs);
+        for (const auto& p : vToCache) {
+            mnListsCache.insert(p.first, p.second);
+        }
     }
 
     return snapshot;
@@ -978,21 +1007,6 @@ bool CDeterministicMNManager::IsDIP3Enforced(int nHeight)
     return nHeight >= Params().GetConsensus().DIP0003EnforcementHeight;
 }
 
-void CDeterministicMNManager::CleanupCache(int nHeight)
-{
-    AssertLockHeld(cs);
-
-    std::vector<uint256> toDelete;
-    for (const auto& p : mnListsCache) {
-        if (p.second.GetHeight() + LISTS_CACHE_SIZE < nHeight) {
-            toDelete.emplace_back(p.first);
-        }
-    }
-    for (const auto& h : toDelete) {
-        mnListsCache.erase(h);
-    }
-}
-
 bool CDeterministicMNManager::UpgradeDiff(CDBBatch& batch, const CBlockIndex* pindexNext, const CDeterministicMNList& curMNList, CDeterministicMNList& newMNList)
 {
     CDataStream oldDiffData(SER_DISK, CLIENT_VERSION);
@@ -10,9 +10,12 @@
 #include "dbwrapper.h"
 #include "evodb.h"
 #include "providertx.h"
+#include "saltedhasher.h"
 #include "simplifiedmns.h"
 #include "sync.h"
+#include "unordered_lru_cache.h"
 
+#include "immer/flex_vector.hpp"
 #include "immer/map.hpp"
 #include "immer/map_transient.hpp"
 
@@ -276,6 +279,9 @@ public:
     typedef immer::map<uint256, CDeterministicMNCPtr> MnMap;
     typedef immer::map<uint64_t, uint256> MnInternalIdMap;
     typedef immer::map<uint256, std::pair<uint256, uint32_t> > MnUniquePropertyMap;
+    // (last paid/revived/registered height, proTxHash), the order in which valid MNs get paid
+    typedef std::pair<int, uint256> PaymentQueueEntry;
+    typedef immer::flex_vector<PaymentQueueEntry> MnPaymentQueue;
 
 private:
     uint256 blockHash;
@@ -288,6 +294,10 @@ private:
     // we keep track of this as checking for duplicates would otherwise be painfully slow
     MnUniquePropertyMap mnUniquePropertyMap;
 
+    // sorted payment queue of all valid MNs, kept up to date by AddMN/UpdateMN/RemoveMN so that
+    // finding the next payees doesn't need to sort the whole list on every block
+    MnPaymentQueue mnPaymentQueue;
+
 public:
     CDeterministicMNList() {}
     explicit CDeterministicMNList(const uint256& _blockHash, int _height, uint32_t _totalRegisteredCount) :
@@ -321,6 +331,7 @@ public:
         mnMap = MnMap();
         mnUniquePropertyMap = MnUniquePropertyMap();
         mnInternalIdMap = MnInternalIdMap();
+        mnPaymentQueue = MnPaymentQueue();
 
         SerializationOpBase(s, CSerActionUnserialize());
 
@@ -338,13 +349,7 @@ public:
 
     size_t GetValidMNsCount() const
     {
-        size_t count = 0;
-        for (const auto& p : mnMap) {
-            if (IsMNValid(p.second)) {
-                count++;
-            }
-        }
-        return count;
+        return mnPaymentQueue.size();
     }
 
     template <typename Callback>
@@ -490,6 +495,9 @@ public:
     }
 
 private:
+    void AddToPaymentQueue(const CDeterministicMNCPtr& dmn);
+    void RemoveFromPaymentQueue(const CDeterministicMNCPtr& dmn);
+
     template <typename T>
     void AddUniqueProperty(const CDeterministicMNCPtr& dmn, const T& v)
     {
@@ -626,6 +634,7 @@ public:
 class CDeterministicMNManager
 {
     static const int SNAPSHOT_LIST_PERIOD = 205; // once per day
+    // Lists within this distance of the tip are kept when they are rebuilt from diffs
     static const int LISTS_CACHE_SIZE = 205;
 
 public:
@@ -634,7 +643,7 @@ public:
 private:
     CEvoDB& evoDb;
 
-    std::map<uint256, CDeterministicMNList> mnListsCache;
+    unordered_lru_cache<uint256, CDeterministicMNList, StaticSaltedHasher, LISTS_CACHE_SIZE * 2> mnListsCache;
     const CBlockIndex* tipIndex{nullptr};
 
 public:
@@ -650,6 +659,7 @@ public:
     void HandleQuorumCommitment(llmq::CFinalCommitment& qc, const CBlockIndex* pindexQuorum, CDeterministicMNList& mnList, bool debugLogs);
     void DecreasePoSePenalties(CDeterministicMNList& mnList);
 
+    // Does not hold cs while reading snapshots and diffs from evoDb
     CDeterministicMNList GetListForBlock(const CBlockIndex* pindex);
     CDeterministicMNList GetListAtChainTip();
 
@@ -662,9 +672,6 @@ public:
     // TODO these can all be removed in a future version
     bool UpgradeDiff(CDBBatch& batch, const CBlockIndex* pindexNext, const CDeterministicMNList& curMNList, CDeterministicMNList& newMNList);
     void UpgradeDBIfNeeded();
-
-private:
-    void CleanupCache(int nHeight);
 };
 
 extern CDeterministicMNManager* deterministicMNManager;
@@ -15,7 +15,12 @@
 #include "base58.h"
 #include "chainparams.h"
 #include "consensus/merkle.h"
+#include "crypto/sha256.h"
+#include "hash.h"
+#include "saltedhasher.h"
+#include "sync.h"
 #include "univalue.h"
+#include "unordered_lru_cache.h"
 #include "validation.h"
 
 CSimplifiedMNListEntry::CSimplifiedMNListEntry(const CDeterministicMN& dmn) :
@@ -86,7 +91,109 @@ uint256 CSimplifiedMNList::CalcMerkleRoot(bool* pmutated) const
     for (const auto& e : mnList) {
         leaves.emplace_back(e->CalcHash());
     }
-    return ComputeMerkleRoot(leaves, pmutated);
+    return ComputeMerkleRoot(std::move(leaves), pmutated);
+}
+
+uint256 CSimplifiedMNListMerkleTree::Update(const CSimplifiedMNList& sml, bool* pmutated)
+{
+    const auto& mnList = sml.mnList;
+
+    bool samePositions = mnList.size() == entries.size();
+    for (size_t i = 0; samePositions && i < mnList.size(); i++) {
+        samePositions = mnList[i]->proRegTxHash == entries[i].proRegTxHash;
+    }
+
+    if (samePositions) {
+        for (size_t i = 0; i < mnList.size(); i++) {
+            if (*mnList[i] != entries[i]) {
+                entries[i] = *mnList[i];
+                UpdateLeaf(i, entries[i].CalcHash());
+            }
+        }
+    } else {
+        // entries were added or removed, so all inner nodes shift. Only hash new or changed entries though, both
+        // lists are sorted by proRegTxHash
+        std::vector<CSimplifiedMNListEntry> newEntries;
+        std::vector<uint256> leaves;
+        newEntries.reserve(mnList.size());
+        leaves.reserve(mnList.size());
+        size_t j = 0;
+        for (const auto& e : mnList) {
+            while (j < entries.size() && entries[j].proRegTxHash.Compare(e->proRegTxHash) < 0) {
+                j++;
+            }
+            if (j < entries.size() && entries[j] == *e) {
+                leaves.emplace_back(levels[0][j]);
+            } else {
+                leaves.emplace_back(e->CalcHash());
+            }
+            newEntries.emplace_back(*e);
+        }
+        entries = std::move(newEntries);
+        Rebuild(std::move(leaves));
+    }
+
+    if (pmutated) {
+        *pmutated = mutatedPairs != 0;
+    }
+    if (levels.empty()) {
+        return uint256();
+    }
+    return levels.back()[0];
+}
+
+void CSimplifiedMNListMerkleTree::Rebuild(std::vector<uint256>&& leaves)
+{
+    levels.clear();
+    mutatedPairs = 0;
+    if (leaves.empty()) {
+        return;
+    }
+
+    levels.emplace_back(std::move(leaves));
+    while (levels.back().size() > 1) {
+        const auto& level = levels.back();
+        for (size_t pos = 0; pos + 1 < level.size(); pos += 2) {
+            if (level[pos] == level[pos + 1]) {
+                mutatedPairs++;
+            }
+        }
+        std::vector<uint256> next(level);
+        if (next.size() & 1) {
+            next.push_back(next.back());
+        }
+        SHA256D64(next[0].begin(), next[0].begin(), next.size() / 2);
+        next.resize(next.size() / 2);
+        levels.emplace_back(std::move(next));
+    }
+}
+
+void CSimplifiedMNListMerkleTree::UpdateLeaf(size_t idx, const uint256& leaf)
+{
+    // the pair containing idx on the given level (the last odd node is paired with itself and never counts as mutated)
+    auto isMutatedPair = [&](size_t l, size_t pos) {
+        size_t left = pos & ~(size_t)1;
+        return left + 1 < levels[l].size() && levels[l][left] == levels[l][left + 1];
+    };
+
+    uint256 h = leaf;
+    for (size_t l = 0; l < levels.size(); l++) {
+        if (l + 1 < levels.size() && isMutatedPair(l, idx)) {
+            mutatedPairs--;
+        }
+        levels[l][idx] = h;
+        if (l + 1 == levels.size()) {
+            break;
+        }
+        if (isMutatedPair(l, idx)) {
+            mutatedPairs++;
+        }
+
+        size_t left = idx & ~(size_t)1;
+        const uint256& right = left + 1 < levels[l].size() ? levels[l][left + 1] : levels[l][left];
+        CHash256().Write(levels[l][left].begin(), 32).Write(right.begin(), 32).Finalize(h.begin());
+        idx /= 2;
+    }
 }
 
 CSimplifiedMNListDiff::CSimplifiedMNListDiff()
@@ -186,6 +293,13 @@ void CSimplifiedMNListDiff::ToJson(UniValue& obj) const
     }
 }
 
+// A diff only depends on the two blocks it was built for, so it stays valid for as long as both blocks are in the active
+// chain (which is checked on every request). Light clients polling at the tip mostly ask for the same few diffs, so only
+// diffs up to MNLISTDIFF_CACHE_MAX_DEPTH blocks below the tip are cached
+static const int MNLISTDIFF_CACHE_MAX_DEPTH = 24;
+static CCriticalSection cs_mnListDiffCache;
+static unordered_lru_cache<uint256, std::shared_ptr<const CSimplifiedMNListDiff>, StaticSaltedHasher, 64> mnListDiffCache;
+
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet)
 {
     AssertLockHeld(cs_main);
@@ -216,6 +330,17 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
         return false;
     }
 
+    uint256 cacheKey = ::SerializeHash(std::make_pair(baseBlockHash, blockHash));
+    bool fCache = chainActive.Height() - blockIndex->nHeight <= MNLISTDIFF_CACHE_MAX_DEPTH;
+    if (fCache) {
+        LOCK(cs_mnListDiffCache);
+        std::shared_ptr<const CSimplifiedMNListDiff> cached;
+        if (mnListDiffCache.get(cacheKey, cached)) {
+            mnListDiffRet = *cached;
+            return true;
+        }
+    }
+
     LOCK(deterministicMNManager->cs);
 
     auto baseDmnList = deterministicMNManager->GetListForBlock(baseBlockIndex);
@@ -249,5 +374,10 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
     vMatch[0] = true; // only coinbase matches
     mnListDiffRet.cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
 
+    if (fCache) {
+        LOCK(cs_mnListDiffCache);
+        mnListDiffCache.insert(cacheKey, std::make_shared<const CSimplifiedMNListDiff>(mnListDiffRet));
+    }
+
     return true;
 }
@@ -84,6 +84,26 @@ public:
     uint256 CalcMerkleRoot(bool* pmutated = NULL) const;
 };
 
+// Keeps the merkle tree of the last SML it was updated with, so that the root of the next SML can be calculated
+// incrementally. Only new or changed entries are hashed and, as long as no entries were added or removed, only the
+// inner nodes on the paths of changed entries are recomputed. The result is identical to CSimplifiedMNList::CalcMerkleRoot
+class CSimplifiedMNListMerkleTree
+{
+private:
+    std::vector<CSimplifiedMNListEntry> entries;
+    // levels[0] holds the leaf hashes and levels.back() the root
+    std::vector<std::vector<uint256>> levels;
+    // number of pairs on all levels with identical hashes, see ComputeMerkleRoot
+    size_t mutatedPairs{0};
+
+public:
+    uint256 Update(const CSimplifiedMNList& sml, bool* pmutated = nullptr);
+
+private:
+    void Rebuild(std::vector<uint256>&& leaves);
+    void UpdateLeaf(size_t idx, const uint256& leaf);
+};
+
 /// P2P messages
 
 class CGetSimplifiedMNListDiff
@@ -7,6 +7,8 @@
 #include "crypto/hmac_sha512.h"
 #include "pubkey.h"
 
+#include <algorithm>
+
 
 inline uint32_t ROTL32(uint32_t x, int8_t r)
 {
@@ -249,3 +251,77 @@ uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint3
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+/** Number of inputs carried through the X11 stages together by HashX11Batch */
+static const size_t X11_BATCH_SIZE = 64;
+
+void HashX11Batch(const unsigned char* in, size_t len, size_t count, uint256* out)
+{
+    static const unsigned char pblank[1] = {0};
+    uint512 a[X11_BATCH_SIZE], b[X11_BATCH_SIZE];
+
+    while (count > 0) {
+        size_t n = std::min(count, X11_BATCH_SIZE);
+
+        sph_blake512_context ctx_blake;
+        for (size_t i = 0; i < n; i++) {
+            sph_blake512_init(&ctx_blake);
+            sph_blake512(&ctx_blake, len ? in + i * len : pblank, len);
+            sph_blake512_close(&ctx_blake, a[i].begin());
+        }
+        sph_bmw512_context ctx_bmw;
+        for (size_t i = 0; i < n; i++) {
+            sph_bmw512_init(&ctx_bmw);
+            sph_bmw512(&ctx_bmw, a[i].begin(), 64);
+            sph_bmw512_close(&ctx_bmw, b[i].begin());
+        }
+        sph_groestl512_context ctx_groestl;
+        for (size_t i = 0; i < n; i++) {
+            sph_groestl512_init(&ctx_groestl);
+            sph_groestl512(&ctx_groestl, b[i].begin(), 64);
+            sph_groestl512_close(&ctx_groestl, a[i].begin());
+        }
+        sph_skein512_context ctx_skein;
+        for (size_t i = 0; i < n; i++) {
+            sph_skein512_init(&ctx_skein);
+            sph_skein512(&ctx_skein, a[i].begin(), 64);
+            sph_skein512_close(&ctx_skein, b[i].begin());
+        }
+        sph_jh512_context ctx_jh;
+        for (size_t i = 0; i < n; i++) {
+            sph_jh512_init(&ctx_jh);
+            sph_jh512(&ctx_jh, b[i].begin(), 64);
+            sph_jh512_close(&ctx_jh, a[i].begin());
+        }
+        sph_keccak512_context ctx_keccak;
+        for (size_t i = 0; i < n; i++) {
+            sph_keccak512_init(&ctx_keccak);
+            sph_keccak512(&ctx_keccak, a[i].begin(), 64);
+            sph_keccak512_close(&ctx_keccak, b[i].begin());
+        }
+        sph_luffa512_context ctx_luffa;
+        for (size_t i = 0; i < n; i++) {
+            sph_luffa512_init(&ctx_luffa);
+            sph_luffa512(&ctx_luffa, b[i].begin(), 64);
+            sph_luffa512_close(&ctx_luffa, a[i].begin());
+        }
+        for (size_t i = 0; i < n; i++)
+            X11CubeHash512_64(a[i].begin(), b[i].begin());
+        for (size_t i = 0; i < n; i++)
+            X11Shavite512_64(b[i].begin(), a[i].begin());
+        sph_simd512_context ctx_simd;
+        for (size_t i = 0; i < n; i++) {
+            sph_simd512_init(&ctx_simd);
+            sph_simd512(&ctx_simd, a[i].begin(), 64);
+            sph_simd512_close(&ctx_simd, b[i].begin());
+        }
+        for (size_t i = 0; i < n; i++) {
+            X11Echo512_64(b[i].begin(), a[i].begin());
+            out[i] = a[i].trim256();
+        }
+
+        in += n * len;
+        out += n;
+        count -= n;
+    }
+}
@@ -28,6 +28,7 @@
 #include "crypto/sph_shavite.h"
 #include "crypto/sph_simd.h"
 #include "crypto/sph_echo.h"
+#include "crypto/x11.h"
 
 #include <vector>
 
@@ -352,10 +353,7 @@ inline uint256 HashX11(const T1 pbegin, const T1 pend)
     sph_keccak512_context    ctx_keccak;
     sph_skein512_context     ctx_skein;
     sph_luffa512_context     ctx_luffa;
-    sph_cubehash512_context  ctx_cubehash;
-    sph_shavite512_context   ctx_shavite;
     sph_simd512_context      ctx_simd;
-    sph_echo512_context      ctx_echo;
     static unsigned char pblank[1];
 
     uint512 hash[11];
@@ -388,25 +386,25 @@ inline uint256 HashX11(const T1 pbegin, const T1 pend)
     sph_luffa512 (&ctx_luffa, static_cast<void*>(&hash[5]), 64);
     sph_luffa512_close(&ctx_luffa, static_cast<void*>(&hash[6]));
 
-    sph_cubehash512_init(&ctx_cubehash);
-    sph_cubehash512 (&ctx_cubehash, static_cast<const void*>(&hash[6]), 64);
-    sph_cubehash512_close(&ctx_cubehash, static_cast<void*>(&hash[7]));
+    X11CubeHash512_64(hash[6].begin(), hash[7].begin());
 
-    sph_shavite512_init(&ctx_shavite);
-    sph_shavite512(&ctx_shavite, static_cast<const void*>(&hash[7]), 64);
-    sph_shavite512_close(&ctx_shavite, static_cast<void*>(&hash[8]));
+    X11Shavite512_64(hash[7].begin(), hash[8].begin());
 
     sph_simd512_init(&ctx_simd);
     sph_simd512 (&ctx_simd, static_cast<const void*>(&hash[8]), 64);
     sph_simd512_close(&ctx_simd, static_cast<void*>(&hash[9]));
 
-    sph_echo512_init(&ctx_echo);
-    sph_echo512 (&ctx_echo, static_cast<const void*>(&hash[9]), 64);
-    sph_echo512_close(&ctx_echo, static_cast<void*>(&hash[10]));
+    X11Echo512_64(hash[9].begin(), hash[10].begin());
 
     return hash[10].trim256();
 }
 
+/** X11 hashes of count consecutive inputs of len bytes each, e.g. serialized headers.
+ *  The batch is hashed one stage at a time, so each stage's code and tables stay in
+ *  cache across all inputs instead of being evicted by the other ten stages.
+ */
+void HashX11Batch(const unsigned char* in, size_t len, size_t count, uint256* out);
+
 template<typename T1>
 inline uint256 HashLegacy(const T1 pbegin, const T1 pend)
 {
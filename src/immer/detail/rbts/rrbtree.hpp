@@ -16,6 +16,7 @@
 #include <immer/detail/type_traits.hpp>
 
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <numeric>
 
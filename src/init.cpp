@@ -21,9 +21,12 @@
 #include "checkpoints.h"
 #include "compat/sanity.h"
 #include "consensus/validation.h"
+#include "crypto/sha256.h"
+#include "crypto/x11.h"
 #include "httpserver.h"
 #include "httprpc.h"
 #include "key.h"
+#include "messagesigcache.h"
 #include "validation.h"
 #include "miner.h"
 #include "netbase.h"
@@ -37,6 +40,8 @@
 #include "scheduler.h"
 #include "timedata.h"
 #include "txdb.h"
+#include "blockcache.h"
+#include "blockfilemap.h"
 #include "txmempool.h"
 #include "torcontrol.h"
 #include "ui_interface.h"
@@ -244,6 +249,7 @@ void PrepareShutdown()
 
     StopHTTPServer();
     llmq::StopLLMQSystem();
+    StopTxMessageCheckThreads();
 
     // fRPCInWarmup should be `false` if we completed the loading sequence
     // before a shutdown request was received
@@ -451,7 +457,18 @@ std::string HelpMessage(HelpMessageMode mode)
     }
     strUsage += HelpMessageOpt("-datadir=<dir>", _("Specify data directory"));
     strUsage += HelpMessageOpt("-dbcache=<n>", strprintf(_("Set database cache size in megabytes (%d to %d, default: %d)"), nMinDbCache, nMaxDbCache, nDefaultDbCache));
+    if (showDebug) {
+        strUsage += HelpMessageOpt("-dbblocksize=<[db:]n>", strprintf("Set LevelDB table block size in KiB (1 to 1024, default: %d). Prefix with chainstate:, index:, evodb: or llmq: to tune a single database", DEFAULT_DB_BLOCK_SIZE));
+        strUsage += HelpMessageOpt("-dbbloombits=<[db:]n>", strprintf("Set LevelDB bloom filter bits per key, 0 to disable (default: %d). Accepts the same database prefixes as -dbblocksize", DEFAULT_DB_BLOOM_BITS));
+        strUsage += HelpMessageOpt("-dbcompression=<[db:]type>", strprintf("Set LevelDB compression, none or snappy (default: %s). Accepts the same database prefixes as -dbblocksize; use -forcecompactdb to rewrite existing tables", DEFAULT_DB_COMPRESSION));
+    }
     strUsage += HelpMessageOpt("-loadblock=<file>", _("Imports blocks from external blk000??.dat file on startup"));
+    if (showDebug) {
+        strUsage += HelpMessageOpt("-appcachettl=<n>", strprintf("Expire prayers, messages and other non-consensus application cache entries after <n> days, 0 to keep them (default: %u)", DEFAULT_APPLICATION_CACHE_TTL));
+        strUsage += HelpMessageOpt("-maxappcache=<n>", strprintf("Keep the non-consensus application cache sections below <n> megabytes, 0 for no limit (default: %u)", DEFAULT_MAX_APPLICATION_CACHE));
+        strUsage += HelpMessageOpt("-maxblockcache=<n>", strprintf("Keep up to <n> megabytes of recently connected or read blocks in memory, 0 to disable (default: %u)", DEFAULT_MAX_BLOCK_CACHE));
+        strUsage += HelpMessageOpt("-maxmappedblockfiles=<n>", strprintf("Keep up to <n> block files memory mapped for reading blocks, 0 to disable (default: %u)", DEFAULT_MAX_MAPPED_BLOCK_FILES));
+    }
     strUsage += HelpMessageOpt("-maxorphantxsize=<n>", strprintf(_("Maximum total size of all orphan transactions in megabytes (default: %u)"), DEFAULT_MAX_ORPHAN_TRANSACTIONS_SIZE));
     strUsage += HelpMessageOpt("-maxmempool=<n>", strprintf(_("Keep the transaction memory pool below <n> megabytes (default: %u)"), DEFAULT_MAX_MEMPOOL_SIZE));
     strUsage += HelpMessageOpt("-mempoolexpiry=<n>", strprintf(_("Do not keep transactions in the mempool longer than <n> hours (default: %u)"), DEFAULT_MEMPOOL_EXPIRY));
@@ -466,6 +483,9 @@ std::string HelpMessage(HelpMessageMode mode)
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >%u = automatically prune block files to stay under the specified target size in MiB)"), MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024));
     strUsage += HelpMessageOpt("-reindex-chainstate", _("Rebuild chain state from the currently indexed blocks"));
     strUsage += HelpMessageOpt("-reindex", _("Rebuild chain state and block index from the blk*.dat files on disk"));
+    if (showDebug)
+        strUsage += HelpMessageOpt("-reindexthreads=<n>", strprintf("Number of threads deserializing and hashing blocks during -reindex and -loadblock (1 to %d, 0 = auto, default: %d). "
+            "Each one uses a RandomX VM of about 2 MB, all of them share one 256 MB RandomX cache per key", MAX_REINDEX_THREADS, DEFAULT_REINDEX_THREADS));
 #ifndef WIN32
     strUsage += HelpMessageOpt("-sysperms", _("Create new files with system default permissions, instead of umask 077 (only effective with disabled wallet functionality)"));
 #endif
@@ -575,6 +595,7 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS));
         strUsage += HelpMessageOpt("-logthreadnames", strprintf("Add thread names to debug messages (default: %u)", DEFAULT_LOGTHREADNAMES));
         strUsage += HelpMessageOpt("-mocktime=<n>", "Replace actual time with <n> seconds since epoch (default: 0)");
+        strUsage += HelpMessageOpt("-maxmsgsigcachesize=<n>", strprintf("Limit size of the ABN/GSC message signature cache to <n> MiB (default: %u)", DEFAULT_MAX_MSG_SIG_CACHE_SIZE));
         strUsage += HelpMessageOpt("-maxsigcachesize=<n>", strprintf("Limit size of signature cache to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE));
         strUsage += HelpMessageOpt("-maxtipage=<n>", strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)", DEFAULT_MAX_TIP_AGE));
     }
@@ -1247,6 +1268,11 @@ bool AppInitParameterInteraction()
     else if (nScriptCheckThreads > MAX_SCRIPTCHECK_THREADS)
         nScriptCheckThreads = MAX_SCRIPTCHECK_THREADS;
 
+    blockFileMapCache.SetMaxFiles(std::max((int64_t)0, GetArg("-maxmappedblockfiles", DEFAULT_MAX_MAPPED_BLOCK_FILES)));
+    recentBlockCache.SetMaxBytes(std::max((int64_t)0, GetArg("-maxblockcache", DEFAULT_MAX_BLOCK_CACHE)) << 20);
+    SetApplicationCacheLimits(std::max((int64_t)0, GetArg("-maxappcache", DEFAULT_MAX_APPLICATION_CACHE)) << 20,
+                              std::max((int64_t)0, GetArg("-appcachettl", DEFAULT_APPLICATION_CACHE_TTL)) * 86400);
+
     // block pruning; get the amount of disk space (in MiB) to allot for block & undo files
     int64_t nPruneArg = GetArg("-prune", 0);
     if (nPruneArg < 0) {
@@ -1487,6 +1513,10 @@ bool AppInitSanityChecks()
     // ********************************************************* Step 4: sanity checks
 
     // Initialize elliptic curve code
+    std::string sha256_algo = SHA256AutoDetect();
+    LogPrintf("Using the '%s' SHA256 implementation\n", sha256_algo);
+    std::string x11_algo = X11AutoDetect();
+    LogPrintf("Using the '%s' X11 implementation\n", x11_algo);
     ECC_Start();
     globalVerifyHandle.reset(new ECCVerifyHandle());
 
@@ -1531,6 +1561,7 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
     LogPrintf("Using at most %i automatic connections (%i file descriptors available)\n", nMaxConnections, nFD);
 
     InitSignatureCache();
+    InitMessageSignatureCache();
 
     LogPrintf("Using %u threads for script verification\n", nScriptCheckThreads);
     if (nScriptCheckThreads) {
@@ -2158,6 +2189,8 @@ bool AppInitMain(boost::thread_group& threadGroup, CScheduler& scheduler)
 
         scheduler.scheduleEvery(boost::bind(&CInstantSend::DoMaintenance, boost::ref(instantsend)), 60 * 1000);
 
+        scheduler.scheduleEvery(&ExpireApplicationCache, 60 * 10 * 1000);
+
         if (fMasternodeMode)
             scheduler.scheduleEvery(boost::bind(&CPrivateSendServer::DoMaintenance, boost::ref(privateSendServer), boost::ref(*g_connman)), 1 * 1000);
 #ifdef ENABLE_WALLET
@@ -255,6 +255,29 @@ bool CDKGSession::PreVerifyMessage(const uint256& hash, const CDKGContribution&
     return true;
 }
 
+void CDKGSession::PrepareMessages(const std::vector<std::pair<uint256, const CDKGContribution*>>& msgs)
+{
+    if (!AreWeMember() || msgs.empty()) {
+        return;
+    }
+
+    // decrypt our shares of the whole batch in parallel
+    std::vector<std::pair<bool, CBLSSecretKey>> results(msgs.size());
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(msgs.size());
+    for (size_t i = 0; i < msgs.size(); i++) {
+        jobs.emplace_back([&, i]() {
+            auto& result = results[i];
+            result.first = msgs[i].second->contributions->Decrypt(myIdx, *activeMasternodeInfo.blsKeyOperator, result.second, PROTOCOL_VERSION);
+        });
+    }
+    blsWorker.RunJobs(jobs);
+
+    for (size_t i = 0; i < msgs.size(); i++) {
+        preparedSkContributions[msgs[i].first] = std::move(results[i]);
+    }
+}
+
 void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc, bool& retBan)
 {
     CDKGLogger logger(*this, __func__);
@@ -263,6 +286,15 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
 
     auto member = GetMember(qc.proTxHash);
 
+    bool prepared = false;
+    std::pair<bool, CBLSSecretKey> preparedSkContribution;
+    auto itPrepared = preparedSkContributions.find(hash);
+    if (itPrepared != preparedSkContributions.end()) {
+        prepared = true;
+        preparedSkContribution = std::move(itPrepared->second);
+        preparedSkContributions.erase(itPrepared);
+    }
+
     cxxtimer::Timer t1(true);
     logger.Batch("received contribution from %s", qc.proTxHash.ToString());
 
@@ -319,7 +351,14 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
 
     bool complain = false;
     CBLSSecretKey skContribution;
-    if (!qc.contributions->Decrypt(myIdx, *activeMasternodeInfo.blsKeyOperator, skContribution, PROTOCOL_VERSION)) {
+    bool decrypted;
+    if (prepared) {
+        decrypted = preparedSkContribution.first;
+        skContribution = preparedSkContribution.second;
+    } else {
+        decrypted = qc.contributions->Decrypt(myIdx, *activeMasternodeInfo.blsKeyOperator, skContribution, PROTOCOL_VERSION);
+    }
+    if (!decrypted) {
         logger.Batch("contribution from %s could not be decrypted", member->dmn->proTxHash.ToString());
         complain = true;
     } else if (member->idx != myIdx && ShouldSimulateError("complain-lie")) {
@@ -1086,44 +1125,29 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGPrematureCommitm
         member->prematureCommitments.emplace(hash);
     }
 
-    std::vector<uint16_t> memberIndexes;
-    std::vector<BLSVerificationVectorPtr> vvecs;
-    BLSSecretKeyVector skContributions;
-    BLSVerificationVectorPtr quorumVvec;
-    if (dkgManager.GetVerifiedContributions(params.type, pindexQuorum, qc.validMembers, memberIndexes, vvecs, skContributions)) {
-        quorumVvec = cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
+    bool fValid;
+    bool fVerified;
+    std::string strError;
+    auto itPrepared = preparedCommitments.find(hash);
+    if (itPrepared != preparedCommitments.end()) {
+        fValid = itPrepared->second.fValid;
+        fVerified = itPrepared->second.fVerified;
+        strError = std::move(itPrepared->second.strError);
+        preparedCommitments.erase(itPrepared);
+    } else {
+        fValid = VerifyPrematureCommitment(qc, fVerified, strError);
     }
 
-    if (quorumVvec == nullptr) {
+    if (!fVerified) {
         logger.Batch("failed to build quorum verification vector. skipping full verification");
         // we might be the unlucky one who didn't receive all contributions, but we still have to relay
         // the premature commitment as others might be luckier
-    } else {
-        // we got all information that is needed to verify everything (even though we might not be a member of the quorum)
-        // if any of this verification fails, we won't relay this message. This ensures that invalid messages are lost
+    } else if (!fValid) {
+        // if any of the verification fails, we won't relay this message. This ensures that invalid messages are lost
         // in the network. Nodes relaying such invalid messages to us are not punished as they might have not known
         // all contributions. We only handle up to 2 commitments per member, so a DoS shouldn't be possible
-
-        if ((*quorumVvec)[0] != qc.quorumPublicKey) {
-            logger.Batch("calculated quorum public key does not match");
-            return;
-        }
-        uint256 vvecHash = ::SerializeHash(*quorumVvec);
-        if (qc.quorumVvecHash != vvecHash) {
-            logger.Batch("calculated quorum vvec hash does not match");
-            return;
-        }
-
-        CBLSPublicKey pubKeyShare = cache.BuildPubKeyShare(::SerializeHash(std::make_pair(memberIndexes, member->id)), quorumVvec, member->id);
-        if (!pubKeyShare.IsValid()) {
-            logger.Batch("failed to calculate public key share");
-            return;
-        }
-
-        if (!qc.quorumSig.VerifyInsecure(pubKeyShare, qc.GetSignHash())) {
-            logger.Batch("failed to verify quorumSig");
-            return;
-        }
+        logger.Batch("%s", strError);
+        return;
     }
 
     LOCK(invCs);
@@ -1150,6 +1174,88 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGPrematureCommitm
     logger.Batch("verified premature commitment. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
 }
 
+bool CDKGSession::VerifyPrematureCommitment(const CDKGPrematureCommitment& qc, bool& fVerifiedRet, std::string& strErrorRet)
+{
+    fVerifiedRet = false;
+
+    auto member = GetMember(qc.proTxHash);
+
+    std::vector<uint16_t> memberIndexes;
+    std::vector<BLSVerificationVectorPtr> vvecs;
+    BLSSecretKeyVector skContributions;
+    BLSVerificationVectorPtr quorumVvec;
+    if (dkgManager.GetVerifiedContributions(params.type, pindexQuorum, qc.validMembers, memberIndexes, vvecs, skContributions)) {
+        quorumVvec = cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
+    }
+    if (quorumVvec == nullptr) {
+        return true;
+    }
+
+    // we got all information that is needed to verify everything (even though we might not be a member of the quorum)
+    fVerifiedRet = true;
+
+    if ((*quorumVvec)[0] != qc.quorumPublicKey) {
+        strErrorRet = "calculated quorum public key does not match";
+        return false;
+    }
+    uint256 vvecHash = ::SerializeHash(*quorumVvec);
+    if (qc.quorumVvecHash != vvecHash) {
+        strErrorRet = "calculated quorum vvec hash does not match";
+        return false;
+    }
+
+    CBLSPublicKey pubKeyShare = cache.BuildPubKeyShare(::SerializeHash(std::make_pair(memberIndexes, member->id)), quorumVvec, member->id);
+    if (!pubKeyShare.IsValid()) {
+        strErrorRet = "failed to calculate public key share";
+        return false;
+    }
+
+    if (!qc.quorumSig.VerifyInsecure(pubKeyShare, qc.GetSignHash())) {
+        strErrorRet = "failed to verify quorumSig";
+        return false;
+    }
+
+    return true;
+}
+
+void CDKGSession::PrepareMessages(const std::vector<std::pair<uint256, const CDKGPrematureCommitment*>>& msgs)
+{
+    if (msgs.empty()) {
+        return;
+    }
+
+    // Building the quorum vvec uses the worker pool itself, so it must not happen inside of a job. Build (and cache)
+    // it here for every distinct set of valid members, the jobs will then only hit the cache
+    std::set<std::vector<bool>> validMembersSet;
+    for (const auto& p : msgs) {
+        if (!validMembersSet.emplace(p.second->validMembers).second) {
+            continue;
+        }
+        std::vector<uint16_t> memberIndexes;
+        std::vector<BLSVerificationVectorPtr> vvecs;
+        BLSSecretKeyVector skContributions;
+        if (dkgManager.GetVerifiedContributions(params.type, pindexQuorum, p.second->validMembers, memberIndexes, vvecs, skContributions)) {
+            cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
+        }
+    }
+
+    // pubkey share calculation and quorumSig verification in parallel
+    std::vector<PreparedCommitment> results(msgs.size());
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(msgs.size());
+    for (size_t i = 0; i < msgs.size(); i++) {
+        jobs.emplace_back([&, i]() {
+            auto& result = results[i];
+            result.fValid = VerifyPrematureCommitment(*msgs[i].second, result.fVerified, result.strError);
+        });
+    }
+    blsWorker.RunJobs(jobs);
+
+    for (size_t i = 0; i < msgs.size(); i++) {
+        preparedCommitments[msgs[i].first] = std::move(results[i]);
+    }
+}
+
 std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
 {
     if (!AreWeMember()) {
@@ -1180,7 +1286,21 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
         it->second.emplace_back(qc);
     }
 
-    std::vector<CFinalCommitment> finalCommitments;
+    struct FinalCommitmentJob {
+        CFinalCommitment fqc;
+        uint256 commitmentHash;
+        std::vector<CBLSSignature> aggSigs;
+        std::vector<CBLSPublicKey> aggPks;
+        std::vector<CBLSId> signerIds;
+        std::vector<CBLSSignature> thresholdSigs;
+        bool recovered{false};
+        int64_t aggregateTime{0};
+        int64_t recoverTime{0};
+
+        FinalCommitmentJob(const Consensus::LLMQParams& params, const uint256& quorumHash) : fqc(params, quorumHash) {}
+    };
+    std::vector<FinalCommitmentJob> fqcJobs;
+
     for (const auto& p : commitmentsMap) {
         auto& cvec = p.second;
         if (cvec.size() < params.minSize) {
@@ -1188,22 +1308,19 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
             continue;
         }
 
-        std::vector<CBLSId> signerIds;
-        std::vector<CBLSSignature> thresholdSigs;
-
         auto& first = cvec[0];
 
-        CFinalCommitment fqc(params, first.quorumHash);
+        fqcJobs.emplace_back(params, first.quorumHash);
+        auto& job = fqcJobs.back();
+        auto& fqc = job.fqc;
         fqc.validMembers = first.validMembers;
         fqc.quorumPublicKey = first.quorumPublicKey;
         fqc.quorumVvecHash = first.quorumVvecHash;
 
-        uint256 commitmentHash = CLLMQUtils::BuildCommitmentHash(fqc.llmqType, fqc.quorumHash, fqc.validMembers, fqc.quorumPublicKey, fqc.quorumVvecHash);
+        job.commitmentHash = CLLMQUtils::BuildCommitmentHash(fqc.llmqType, fqc.quorumHash, fqc.validMembers, fqc.quorumPublicKey, fqc.quorumVvecHash);
 
-        std::vector<CBLSSignature> aggSigs;
-        std::vector<CBLSPublicKey> aggPks;
-        aggSigs.reserve(cvec.size());
-        aggPks.reserve(cvec.size());
+        job.aggSigs.reserve(cvec.size());
+        job.aggPks.reserve(cvec.size());
 
         for (size_t i = 0; i < cvec.size(); i++) {
             auto& qc = cvec[i];
@@ -1217,29 +1334,46 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
             const auto& m = members[signerIndex];
 
             fqc.signers[signerIndex] = true;
-            aggSigs.emplace_back(qc.sig);
-            aggPks.emplace_back(m->dmn->pdmnState->pubKeyOperator.Get());
+            job.aggSigs.emplace_back(qc.sig);
+            job.aggPks.emplace_back(m->dmn->pdmnState->pubKeyOperator.Get());
 
-            signerIds.emplace_back(m->id);
-            thresholdSigs.emplace_back(qc.quorumSig);
+            job.signerIds.emplace_back(m->id);
+            job.thresholdSigs.emplace_back(qc.quorumSig);
         }
+    }
 
-        cxxtimer::Timer t1(true);
-        fqc.membersSig = CBLSSignature::AggregateSecure(aggSigs, aggPks, commitmentHash);
-        t1.stop();
+    // aggregation of the members sig and recovery of the quorum sig are independent, so run all of them in parallel
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(fqcJobs.size() * 2);
+    for (auto& job : fqcJobs) {
+        jobs.emplace_back([&job]() {
+            cxxtimer::Timer t1(true);
+            job.fqc.membersSig = CBLSSignature::AggregateSecure(job.aggSigs, job.aggPks, job.commitmentHash);
+            t1.stop();
+            job.aggregateTime = t1.count();
+        });
+        jobs.emplace_back([&job]() {
+            cxxtimer::Timer t2(true);
+            job.recovered = job.fqc.quorumSig.Recover(job.thresholdSigs, job.signerIds);
+            t2.stop();
+            job.recoverTime = t2.count();
+        });
+    }
+    blsWorker.RunJobs(jobs);
 
-        cxxtimer::Timer t2(true);
-        if (!fqc.quorumSig.Recover(thresholdSigs, signerIds)) {
+    std::vector<CFinalCommitment> finalCommitments;
+    for (auto& job : fqcJobs) {
+        auto& fqc = job.fqc;
+        if (!job.recovered) {
             logger.Batch("failed to recover quorum sig");
             continue;
         }
-        t2.stop();
 
         finalCommitments.emplace_back(fqc);
 
         logger.Batch("final commitment: validMembers=%d, signers=%d, quorumPublicKey=%s, time1=%d, time2=%d",
                         fqc.CountValidMembers(), fqc.CountSigners(), fqc.quorumPublicKey.ToString(),
-                        t1.count(), t2.count());
+                        job.aggregateTime, job.recoverTime);
     }
 
     logger.Flush();
@@ -282,6 +282,15 @@ private:
     // filled by ReceivePrematureCommitment and used by FinalizeCommitments
     std::set<uint256> validCommitments;
 
+    // results of PrepareMessages, indexed by msg hash and consumed by ReceiveMessage. Only accessed by the handler thread
+    struct PreparedCommitment {
+        bool fValid;
+        bool fVerified;
+        std::string strError;
+    };
+    std::map<uint256, std::pair<bool, CBLSSecretKey>> preparedSkContributions;
+    std::map<uint256, PreparedCommitment> preparedCommitments;
+
 public:
     CDKGSession(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager) :
         params(_params), blsWorker(_blsWorker), cache(_blsWorker), dkgManager(_dkgManager) {}
@@ -298,7 +307,8 @@ public:
      *    that does not require too much resources for verification. This specifically excludes all CPU intensive BLS
      *    operations.
      * 3. CDKGSessionHandler will collect pre verified messages in batches and perform batched BLS signature verification
-     *    on these.
+     *    on these. It then calls PrepareMessages with the whole batch, which does the CPU intensive parts of ReceiveMessage
+     *    that don't depend on session state in parallel on the BLS worker pool.
      * 4. ReceiveMessage is called for each pre verified message with a valid signature. ReceiveMessage is also
      *    responsible for further verification of validity (e.g. validate vvecs and SK contributions).
      */
@@ -307,6 +317,7 @@ public:
     void Contribute(CDKGPendingMessages& pendingMessages);
     void SendContributions(CDKGPendingMessages& pendingMessages);
     bool PreVerifyMessage(const uint256& hash, const CDKGContribution& qc, bool& retBan) const;
+    void PrepareMessages(const std::vector<std::pair<uint256, const CDKGContribution*>>& msgs);
     void ReceiveMessage(const uint256& hash, const CDKGContribution& qc, bool& retBan);
     void VerifyPendingContributions();
 
@@ -326,11 +337,16 @@ public:
     void VerifyAndCommit(CDKGPendingMessages& pendingMessages);
     void SendCommitment(CDKGPendingMessages& pendingMessages);
     bool PreVerifyMessage(const uint256& hash, const CDKGPrematureCommitment& qc, bool& retBan) const;
+    void PrepareMessages(const std::vector<std::pair<uint256, const CDKGPrematureCommitment*>>& msgs);
     void ReceiveMessage(const uint256& hash, const CDKGPrematureCommitment& qc, bool& retBan);
 
     // Phase 5: aggregate/finalize
     std::vector<CFinalCommitment> FinalizeCommitments();
 
+    // complaints and justifications have nothing to prepare (justifications are verified asynchronously already)
+    template<typename Message>
+    void PrepareMessages(const std::vector<std::pair<uint256, const Message*>>& msgs) {}
+
     bool AreWeMember() const { return !myProTxHash.IsNull(); }
     void MarkBadMember(size_t idx);
 
@@ -338,6 +354,11 @@ public:
 
 public:
     CDKGMember* GetMember(const uint256& proTxHash) const;
+
+private:
+    // Returns false if the commitment is invalid. fVerifiedRet is false if we could not build the quorum vvec, in which
+    // case the commitment could not be fully verified
+    bool VerifyPrematureCommitment(const CDKGPrematureCommitment& qc, bool& fVerifiedRet, std::string& strErrorRet);
 };
 
 void SetSimulatedDKGErrorRate(const std::string& type, double rate);
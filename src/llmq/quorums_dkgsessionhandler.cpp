@@ -419,6 +419,15 @@ bool ProcessPendingMessageBatch(CDKGSession& session, CDKGPendingMessages& pendi
         }
     }
 
+    std::vector<std::pair<uint256, const Message*>> toPrepare;
+    toPrepare.reserve(preverifiedMessages.size());
+    for (size_t i = 0; i < preverifiedMessages.size(); i++) {
+        if (!badNodes.count(preverifiedMessages[i].first)) {
+            toPrepare.emplace_back(hashes[i], preverifiedMessages[i].second.get());
+        }
+    }
+    session.PrepareMessages(toPrepare);
+
     for (size_t i = 0; i < preverifiedMessages.size(); i++) {
         NodeId nodeId = preverifiedMessages[i].first;
         if (badNodes.count(nodeId)) {
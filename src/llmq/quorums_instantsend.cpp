@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "quorums_chainlocks.h"
+#include "quorums_init.h"
 #include "quorums_instantsend.h"
 #include "quorums_utils.h"
 
@@ -797,7 +798,9 @@ std::unordered_set<uint256> CInstantSendManager::ProcessPendingInstantSendLocks(
 {
     auto llmqType = Params().GetConsensus().llmqForInstantSend;
 
-    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, true, 8);
+    // Instead of verifying synchronous sub-batches while collecting, verify everything at the end in per-node shards
+    // on the BLS worker pool
+    CBLSShardedBatchVerifier<NodeId, uint256> batchVerifier(false, true);
     std::unordered_map<uint256, std::pair<CQuorumCPtr, CRecoveredSig>> recSigs;
 
     for (const auto& p : pend) {
@@ -845,7 +848,7 @@ std::unordered_set<uint256> CInstantSendManager::ProcessPendingInstantSendLocks(
         }
     }
 
-    batchVerifier.Verify();
+    batchVerifier.Verify(blsWorker);
 
     std::unordered_set<uint256> badISLocks;
 
@@ -2,6 +2,7 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "quorums_init.h"
 #include "quorums_signing.h"
 #include "quorums_utils.h"
 #include "quorums_signing_shares.h"
@@ -52,6 +53,11 @@ CRecoveredSigsDb::CRecoveredSigsDb(CDBWrapper& _db) :
     }
 }
 
+CRecoveredSigsDb::~CRecoveredSigsDb()
+{
+    FlushPendingVotes();
+}
+
 // This converts time values in "rs_t" from host endiannes to big endiannes, which is required to have proper ordering of the keys
 void CRecoveredSigsDb::ConvertInvalidTimeKeys()
 {
@@ -127,8 +133,31 @@ void CRecoveredSigsDb::AddVoteTimeKeys()
 
 bool CRecoveredSigsDb::HasRecoveredSig(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash)
 {
+    auto cacheKey = std::make_pair(llmqType, id);
+    {
+        LOCK(cs);
+        uint256 cachedMsgHash;
+        if (msgHashForIdCache.get(cacheKey, cachedMsgHash)) {
+            nCacheHits++;
+            return cachedMsgHash == msgHash;
+        }
+        bool hasSigForId;
+        if (hasSigForIdCache.get(cacheKey, hasSigForId) && !hasSigForId) {
+            nCacheHits++;
+            return false;
+        }
+        nCacheMisses++;
+    }
+
     auto k = std::make_tuple(std::string("rs_r"), (uint8_t)llmqType, id, msgHash);
-    return db.Exists(k);
+    bool ret = db.Exists(k);
+
+    if (ret) {
+        // a miss only tells us that this msgHash is not the one, so only positive results can be cached here
+        LOCK(cs);
+        msgHashForIdCache.insert(cacheKey, msgHash);
+    }
+    return ret;
 }
 
 bool CRecoveredSigsDb::HasRecoveredSigForId(Consensus::LLMQType llmqType, const uint256& id)
@@ -138,8 +167,10 @@ bool CRecoveredSigsDb::HasRecoveredSigForId(Consensus::LLMQType llmqType, const
     {
         LOCK(cs);
         if (hasSigForIdCache.get(cacheKey, ret)) {
+            nCacheHits++;
             return ret;
         }
+        nCacheMisses++;
     }
 
 
@@ -157,8 +188,10 @@ bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash)
     {
         LOCK(cs);
         if (hasSigForSessionCache.get(signHash, ret)) {
+            nCacheHits++;
             return ret;
         }
+        nCacheMisses++;
     }
 
     auto k = std::make_tuple(std::string("rs_s"), signHash);
@@ -175,8 +208,10 @@ bool CRecoveredSigsDb::HasRecoveredSigForHash(const uint256& hash)
     {
         LOCK(cs);
         if (hasSigForHashCache.get(hash, ret)) {
+            nCacheHits++;
             return ret;
         }
+        nCacheMisses++;
     }
 
     auto k = std::make_tuple(std::string("rs_h"), hash);
@@ -222,10 +257,38 @@ bool CRecoveredSigsDb::GetRecoveredSigById(Consensus::LLMQType llmqType, const u
 
 void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
 {
+    WriteRecoveredSigs({recSig});
+}
+
+void CRecoveredSigsDb::WriteRecoveredSigs(const std::vector<CRecoveredSig>& recSigs)
+{
+    if (recSigs.empty()) {
+        return;
+    }
+
     CDBBatch batch(db);
 
     uint32_t curTime = GetAdjustedTime();
+    for (const auto& recSig : recSigs) {
+        WriteRecoveredSig(batch, recSig, curTime);
+    }
 
+    db.WriteBatch(batch);
+
+    LOCK(cs);
+    nObjectsWritten += recSigs.size();
+    nKeysWritten += recSigs.size() * 5;
+    nBatchesWritten++;
+    for (const auto& recSig : recSigs) {
+        hasSigForIdCache.insert(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.id), true);
+        msgHashForIdCache.insert(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.id), recSig.msgHash);
+        hasSigForSessionCache.insert(CLLMQUtils::BuildSignHash(recSig), true);
+        hasSigForHashCache.insert(recSig.GetHash(), true);
+    }
+}
+
+void CRecoveredSigsDb::WriteRecoveredSig(CDBBatch& batch, const llmq::CRecoveredSig& recSig, uint32_t curTime)
+{
     // we put these close to each other to leverage leveldb's key compaction
     // this way, the second key can be used for fast HasRecoveredSig checks while the first key stores the recSig
     auto k1 = std::make_tuple(std::string("rs_r"), recSig.llmqType, recSig.id);
@@ -246,17 +309,6 @@ void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
     // store by current time. Allows fast cleanup of old recSigs
     auto k5 = std::make_tuple(std::string("rs_t"), (uint32_t)htobe32(curTime), recSig.llmqType, recSig.id);
     batch.Write(k5, (uint8_t)1);
-
-    db.WriteBatch(batch);
-
-    {
-        int64_t t = GetTimeMillis();
-
-        LOCK(cs);
-        hasSigForIdCache.insert(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.id), true);
-        hasSigForSessionCache.insert(signHash, true);
-        hasSigForHashCache.insert(recSig.GetHash(), true);
-    }
 }
 
 void CRecoveredSigsDb::RemoveRecoveredSig(CDBBatch& batch, Consensus::LLMQType llmqType, const uint256& id, bool deleteTimeKey)
@@ -291,6 +343,7 @@ void CRecoveredSigsDb::RemoveRecoveredSig(CDBBatch& batch, Consensus::LLMQType l
     }
 
     hasSigForIdCache.erase(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.id));
+    msgHashForIdCache.erase(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.id));
     hasSigForSessionCache.erase(signHash);
     hasSigForHashCache.erase(recSig.GetHash());
 }
@@ -359,26 +412,74 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
 
 bool CRecoveredSigsDb::HasVotedOnId(Consensus::LLMQType llmqType, const uint256& id)
 {
-    auto k = std::make_tuple(std::string("rs_v"), (uint8_t)llmqType, id);
-    return db.Exists(k);
+    uint256 msgHash;
+    return GetVoteForId(llmqType, id, msgHash);
 }
 
 bool CRecoveredSigsDb::GetVoteForId(Consensus::LLMQType llmqType, const uint256& id, uint256& msgHashRet)
 {
+    auto cacheKey = std::make_pair(llmqType, id);
+
+    // The db read and the cache insert must happen under the same lock. Otherwise a vote written and cached by
+    // WriteVoteForId (and maybe already flushed) while we read could be replaced by our stale negative result.
+    LOCK(cs);
+    auto it = pendingVotes.find(cacheKey);
+    if (it != pendingVotes.end()) {
+        nCacheHits++;
+        msgHashRet = it->second;
+        return true;
+    }
+    uint256 cachedMsgHash;
+    if (voteForIdCache.get(cacheKey, cachedMsgHash)) {
+        nCacheHits++;
+        if (cachedMsgHash.IsNull()) {
+            return false;
+        }
+        msgHashRet = cachedMsgHash;
+        return true;
+    }
+    nCacheMisses++;
+
     auto k = std::make_tuple(std::string("rs_v"), (uint8_t)llmqType, id);
-    return db.Read(k, msgHashRet);
+    uint256 msgHash;
+    bool ret = db.Read(k, msgHash);
+    voteForIdCache.insert(cacheKey, ret ? msgHash : uint256());
+    if (ret) {
+        msgHashRet = msgHash;
+    }
+    return ret;
 }
 
 void CRecoveredSigsDb::WriteVoteForId(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash)
 {
-    auto k1 = std::make_tuple(std::string("rs_v"), (uint8_t)llmqType, id);
-    auto k2 = std::make_tuple(std::string("rs_vt"), (uint32_t)htobe32(GetAdjustedTime()), (uint8_t)llmqType, id);
+    auto cacheKey = std::make_pair(llmqType, id);
 
-    CDBBatch batch(db);
-    batch.Write(k1, msgHash);
-    batch.Write(k2, (uint8_t)1);
+    LOCK(cs);
+    pendingVotes[cacheKey] = msgHash;
+    voteForIdCache.insert(cacheKey, msgHash);
+}
+
+void CRecoveredSigsDb::FlushPendingVotes()
+{
+    LOCK(cs);
+    if (pendingVotes.empty()) {
+        return;
+    }
 
+    CDBBatch batch(db);
+    uint32_t curTime = GetAdjustedTime();
+    for (const auto& p : pendingVotes) {
+        auto k1 = std::make_tuple(std::string("rs_v"), (uint8_t)p.first.first, p.first.second);
+        auto k2 = std::make_tuple(std::string("rs_vt"), (uint32_t)htobe32(curTime), (uint8_t)p.first.first, p.first.second);
+        batch.Write(k1, p.second);
+        batch.Write(k2, (uint8_t)1);
+    }
     db.WriteBatch(batch);
+
+    nObjectsWritten += pendingVotes.size();
+    nKeysWritten += pendingVotes.size() * 2;
+    nBatchesWritten++;
+    pendingVotes.clear();
 }
 
 void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
@@ -391,6 +492,7 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 
     CDBBatch batch(db);
     size_t cnt = 0;
+    std::vector<std::pair<Consensus::LLMQType, uint256>> toUncache;
     while (pcursor->Valid()) {
         decltype(start) k;
 
@@ -406,6 +508,7 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 
         batch.Erase(k);
         batch.Erase(std::make_tuple(std::string("rs_v"), llmqType, id));
+        toUncache.emplace_back((Consensus::LLMQType)llmqType, id);
 
         cnt++;
 
@@ -419,9 +522,25 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 
     db.WriteBatch(batch);
 
+    {
+        LOCK(cs);
+        for (const auto& e : toUncache) {
+            voteForIdCache.erase(e);
+        }
+    }
+
     LogPrint("llmq", "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, cnt);
 }
 
+std::string CRecoveredSigsDb::GetStatsString()
+{
+    LOCK(cs);
+    uint64_t nLookups = nCacheHits + nCacheMisses;
+    return strprintf("cacheHits=%d, cacheMisses=%d, hitRate=%.2f%%, objectsWritten=%d, keysWritten=%d, batchesWritten=%d, keysPerObject=%.2f",
+                     nCacheHits, nCacheMisses, nLookups ? 100.0 * nCacheHits / nLookups : 0.0,
+                     nObjectsWritten, nKeysWritten, nBatchesWritten, nObjectsWritten ? (double)nKeysWritten / nObjectsWritten : 0.0);
+}
+
 //////////////////
 
 CSigningManager::CSigningManager(CDBWrapper& llmqDb, bool fMemory) :
@@ -477,7 +596,9 @@ void CSigningManager::ProcessMessageRecoveredSig(CNode* pfrom, const CRecoveredS
             CLLMQUtils::BuildSignHash(recoveredSig).ToString(), recoveredSig.id.ToString(), recoveredSig.msgHash.ToString(), pfrom->GetId());
 
     LOCK(cs);
-    pendingRecoveredSigs[pfrom->id].emplace_back(recoveredSig);
+    auto& v = pendingRecoveredSigs[pfrom->id];
+    v.emplace_back(recoveredSig);
+    v.back().nTimeReceived = GetTimeMillis();
 }
 
 bool CSigningManager::PreVerifyRecoveredSig(NodeId nodeId, const CRecoveredSig& recoveredSig, bool& retBan)
@@ -577,9 +698,16 @@ void CSigningManager::ProcessPendingReconstructedRecoveredSigs()
         LOCK(cs);
         l = std::move(pendingReconstructedRecoveredSigs);
     }
+    if (l.empty()) {
+        return;
+    }
+
+    std::vector<std::tuple<NodeId, CRecoveredSig, CQuorumCPtr>> recSigs;
+    recSigs.reserve(l.size());
     for (auto& p : l) {
-        ProcessRecoveredSig(-1, p.first, p.second, *g_connman);
+        recSigs.emplace_back(-1, std::move(p.first), std::move(p.second));
     }
+    ProcessRecoveredSigs(recSigs, *g_connman);
 }
 
 bool CSigningManager::ProcessPendingRecoveredSigs(CConnman& connman)
@@ -596,7 +724,7 @@ bool CSigningManager::ProcessPendingRecoveredSigs(CConnman& connman)
 
     // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
     // craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, false);
+    CBLSShardedBatchVerifier<NodeId, uint256> batchVerifier(false, false);
 
     size_t verifyCount = 0;
     for (auto& p : recSigsByNode) {
@@ -617,11 +745,13 @@ bool CSigningManager::ProcessPendingRecoveredSigs(CConnman& connman)
     }
 
     cxxtimer::Timer verifyTimer(true);
-    batchVerifier.Verify();
+    batchVerifier.Verify(blsWorker);
     verifyTimer.stop();
 
     LogPrint("llmq", "CSigningManager::%s -- verified recovered sig(s). count=%d, vt=%d, nodes=%d\n", __func__, verifyCount, verifyTimer.count(), recSigsByNode.size());
 
+    std::vector<std::tuple<NodeId, CRecoveredSig, CQuorumCPtr>> validRecSigs;
+    validRecSigs.reserve(verifyCount);
     std::unordered_set<uint256, StaticSaltedHasher> processed;
     for (auto& p : recSigsByNode) {
         NodeId nodeId = p.first;
@@ -640,67 +770,119 @@ bool CSigningManager::ProcessPendingRecoveredSigs(CConnman& connman)
             }
 
             const auto& quorum = quorums.at(std::make_pair((Consensus::LLMQType)recSig.llmqType, recSig.quorumHash));
-            ProcessRecoveredSig(nodeId, recSig, quorum, connman);
+            validRecSigs.emplace_back(nodeId, std::move(recSig), quorum);
         }
     }
 
+    ProcessRecoveredSigs(validRecSigs, connman);
+
     return true;
 }
 
 // signature must be verified already
 void CSigningManager::ProcessRecoveredSig(NodeId nodeId, const CRecoveredSig& recoveredSig, const CQuorumCPtr& quorum, CConnman& connman)
 {
-    auto llmqType = (Consensus::LLMQType)recoveredSig.llmqType;
+    ProcessRecoveredSigs({std::make_tuple(nodeId, recoveredSig, quorum)}, connman);
+}
+
+void CSigningManager::ProcessRecoveredSigs(const std::vector<std::tuple<NodeId, CRecoveredSig, CQuorumCPtr>>& recoveredSigs, CConnman& connman)
+{
+    if (recoveredSigs.empty()) {
+        return;
+    }
 
     {
         LOCK(cs_main);
-        connman.RemoveAskFor(recoveredSig.GetHash());
+        for (const auto& t : recoveredSigs) {
+            connman.RemoveAskFor(std::get<1>(t).GetHash());
+        }
     }
 
     std::vector<CRecoveredSigsListener*> listeners;
+    std::vector<CRecoveredSig> newRecSigs;
+    newRecSigs.reserve(recoveredSigs.size());
     {
         LOCK(cs);
         listeners = recoveredSigsListeners;
 
-        auto signHash = CLLMQUtils::BuildSignHash(recoveredSig);
+        // ids written by this batch, as the db does not know about them until the batch is written
+        std::set<std::pair<Consensus::LLMQType, uint256>> newIds;
+
+        for (const auto& t : recoveredSigs) {
+            NodeId nodeId = std::get<0>(t);
+            const auto& recoveredSig = std::get<1>(t);
+            auto llmqType = (Consensus::LLMQType)recoveredSig.llmqType;
+
+            auto signHash = CLLMQUtils::BuildSignHash(recoveredSig);
 
-        LogPrint("llmq", "CSigningManager::%s -- valid recSig. signHash=%s, id=%s, msgHash=%s, node=%d\n", __func__,
-                signHash.ToString(), recoveredSig.id.ToString(), recoveredSig.msgHash.ToString(), nodeId);
+            LogPrint("llmq", "CSigningManager::%s -- valid recSig. signHash=%s, id=%s, msgHash=%s, node=%d\n", __func__,
+                    signHash.ToString(), recoveredSig.id.ToString(), recoveredSig.msgHash.ToString(), nodeId);
 
-        if (db.HasRecoveredSigForId(llmqType, recoveredSig.id)) {
-            CRecoveredSig otherRecoveredSig;
-            if (db.GetRecoveredSigById(llmqType, recoveredSig.id, otherRecoveredSig)) {
-                auto otherSignHash = CLLMQUtils::BuildSignHash(recoveredSig);
-                if (signHash != otherSignHash) {
-                    // this should really not happen, as each masternode is participating in only one vote,
-                    // even if it's a member of multiple quorums. so a majority is only possible on one quorum and one msgHash per id
-                    LogPrintf("CSigningManager::%s -- conflicting recoveredSig for signHash=%s, id=%s, msgHash=%s, otherSignHash=%s\n", __func__,
-                              signHash.ToString(), recoveredSig.id.ToString(), recoveredSig.msgHash.ToString(), otherSignHash.ToString());
+            if (newIds.count(std::make_pair(llmqType, recoveredSig.id))) {
+                // same id already accepted earlier in this batch. See the already-known case below
+                continue;
+            }
+
+            if (db.HasRecoveredSigForId(llmqType, recoveredSig.id)) {
+                CRecoveredSig otherRecoveredSig;
+                if (db.GetRecoveredSigById(llmqType, recoveredSig.id, otherRecoveredSig)) {
+                    auto otherSignHash = CLLMQUtils::BuildSignHash(recoveredSig);
+                    if (signHash != otherSignHash) {
+                        // this should really not happen, as each masternode is participating in only one vote,
+                        // even if it's a member of multiple quorums. so a majority is only possible on one quorum and one msgHash per id
+                        LogPrintf("CSigningManager::%s -- conflicting recoveredSig for signHash=%s, id=%s, msgHash=%s, otherSignHash=%s\n", __func__,
+                                  signHash.ToString(), recoveredSig.id.ToString(), recoveredSig.msgHash.ToString(), otherSignHash.ToString());
+                    } else {
+                        // Looks like we're trying to process a recSig that is already known. This might happen if the same
+                        // recSig comes in through regular QRECSIG messages and at the same time through some other message
+                        // which allowed to reconstruct a recSig (e.g. ISLOCK). In this case, just bail out.
+                    }
+                    continue;
                 } else {
-                    // Looks like we're trying to process a recSig that is already known. This might happen if the same
-                    // recSig comes in through regular QRECSIG messages and at the same time through some other message
-                    // which allowed to reconstruct a recSig (e.g. ISLOCK). In this case, just bail out.
+                    // This case is very unlikely. It can only happen when cleanup caused this specific recSig to vanish
+                    // between the HasRecoveredSigForId and GetRecoveredSigById call. If that happens, treat it as if we
+                    // never had that recSig
                 }
-                return;
-            } else {
-                // This case is very unlikely. It can only happen when cleanup caused this specific recSig to vanish
-                // between the HasRecoveredSigForId and GetRecoveredSigById call. If that happens, treat it as if we
-                // never had that recSig
             }
+
+            newIds.emplace(llmqType, recoveredSig.id);
+            newRecSigs.emplace_back(recoveredSig);
         }
 
-        db.WriteRecoveredSig(recoveredSig);
+        db.WriteRecoveredSigs(newRecSigs);
     }
 
-    CInv inv(MSG_QUORUM_RECOVERED_SIG, recoveredSig.GetHash());
-    g_connman->ForEachNode([&](CNode* pnode) {
-        if (pnode->nVersion >= LLMQS_PROTO_VERSION && pnode->fSendRecSigs) {
-            pnode->PushInventory(inv);
+    if (newRecSigs.empty()) {
+        return;
+    }
+
+    int64_t nNow = GetTimeMillis();
+    int64_t nLatencySum = 0;
+    int64_t nLatencyMax = 0;
+    size_t nLatencyCount = 0;
+    for (const auto& recoveredSig : newRecSigs) {
+        if (recoveredSig.nTimeReceived != 0) {
+            int64_t nLatency = nNow - recoveredSig.nTimeReceived;
+            nLatencySum += nLatency;
+            nLatencyMax = std::max(nLatencyMax, nLatency);
+            nLatencyCount++;
         }
-    });
 
-    for (auto& l : listeners) {
-        l->HandleNewRecoveredSig(recoveredSig);
+        CInv inv(MSG_QUORUM_RECOVERED_SIG, recoveredSig.GetHash());
+        g_connman->ForEachNode([&](CNode* pnode) {
+            if (pnode->nVersion >= LLMQS_PROTO_VERSION && pnode->fSendRecSigs) {
+                pnode->PushInventory(inv);
+            }
+        });
+
+        for (auto& l : listeners) {
+            l->HandleNewRecoveredSig(recoveredSig);
+        }
+    }
+
+    if (nLatencyCount != 0) {
+        LogPrint("llmq", "CSigningManager::%s -- accepted recovered sig(s). count=%d, avgLatency=%dms, maxLatency=%dms\n", __func__,
+                newRecSigs.size(), nLatencySum / (int64_t)nLatencyCount, nLatencyMax);
     }
 }
 
@@ -708,6 +890,7 @@ void CSigningManager::PushReconstructedRecoveredSig(const llmq::CRecoveredSig& r
 {
     LOCK(cs);
     pendingReconstructedRecoveredSigs.emplace_back(recoveredSig, quorum);
+    pendingReconstructedRecoveredSigs.back().first.nTimeReceived = GetTimeMillis();
 }
 
 void CSigningManager::RemoveRecoveredSig(Consensus::LLMQType llmqType, const uint256& id)
@@ -727,6 +910,11 @@ void CSigningManager::Cleanup()
     db.CleanupOldRecoveredSigs(maxAge);
     db.CleanupOldVotes(maxAge);
 
+    if (now - lastStatsLogTime >= 60 * 1000) {
+        LogPrint("llmq", "CSigningManager::%s -- recovered sigs db: %s\n", __func__, db.GetStatsString());
+        lastStatsLogTime = now;
+    }
+
     lastCleanupTime = GetTimeMillis();
 }
 
@@ -861,6 +1049,11 @@ bool CSigningManager::GetVoteForId(Consensus::LLMQType llmqType, const uint256&
     return db.GetVoteForId(llmqType, id, msgHashRet);
 }
 
+void CSigningManager::FlushPendingVotes()
+{
+    db.FlushPendingVotes();
+}
+
 std::vector<CQuorumCPtr> CSigningManager::GetActiveQuorumSet(Consensus::LLMQType llmqType, int signHeight)
 {
     auto& llmqParams = Params().GetConsensus().llmqs.at(llmqType);
@@ -13,6 +13,8 @@
 #include "univalue.h"
 #include "unordered_lru_cache.h"
 
+#include <map>
+#include <tuple>
 #include <unordered_map>
 
 namespace llmq
@@ -29,6 +31,8 @@ public:
 
     // only in-memory
     uint256 hash;
+    // time (in ms) at which we received this recSig or reconstructed it from another message. Used for latency stats
+    int64_t nTimeReceived{0};
 
 public:
 
@@ -70,9 +74,24 @@ private:
     unordered_lru_cache<std::pair<Consensus::LLMQType, uint256>, bool, StaticSaltedHasher, 30000> hasSigForIdCache;
     unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForSessionCache;
     unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForHashCache;
+    // msgHash of the recSig for an id, or a null hash if we know that there is none
+    unordered_lru_cache<std::pair<Consensus::LLMQType, uint256>, uint256, StaticSaltedHasher, 30000> msgHashForIdCache;
+    // msgHash we voted for on an id, or a null hash if we know that we did not vote
+    unordered_lru_cache<std::pair<Consensus::LLMQType, uint256>, uint256, StaticSaltedHasher, 30000> voteForIdCache;
+
+    // votes which are not written to the db yet, see FlushPendingVotes
+    std::map<std::pair<Consensus::LLMQType, uint256>, uint256> pendingVotes;
+
+    // cache hit rate and write amplification (db keys and batches per written recSig/vote)
+    uint64_t nCacheHits{0};
+    uint64_t nCacheMisses{0};
+    uint64_t nObjectsWritten{0};
+    uint64_t nKeysWritten{0};
+    uint64_t nBatchesWritten{0};
 
 public:
     CRecoveredSigsDb(CDBWrapper& _db);
+    ~CRecoveredSigsDb();
 
     void ConvertInvalidTimeKeys();
     void AddVoteTimeKeys();
@@ -84,6 +103,8 @@ public:
     bool GetRecoveredSigByHash(const uint256& hash, CRecoveredSig& ret);
     bool GetRecoveredSigById(Consensus::LLMQType llmqType, const uint256& id, CRecoveredSig& ret);
     void WriteRecoveredSig(const CRecoveredSig& recSig);
+    // writes all recSigs with a single batch
+    void WriteRecoveredSigs(const std::vector<CRecoveredSig>& recSigs);
     void RemoveRecoveredSig(Consensus::LLMQType llmqType, const uint256& id);
 
     void CleanupOldRecoveredSigs(int64_t maxAge);
@@ -91,12 +112,18 @@ public:
     // votes are removed when the recovered sig is written to the db
     bool HasVotedOnId(Consensus::LLMQType llmqType, const uint256& id);
     bool GetVoteForId(Consensus::LLMQType llmqType, const uint256& id, uint256& msgHashRet);
+    // Votes are only visible through the above methods until FlushPendingVotes writes them to the db. This must happen
+    // before anything gets signed for them
     void WriteVoteForId(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash);
+    void FlushPendingVotes();
 
     void CleanupOldVotes(int64_t maxAge);
 
+    std::string GetStatsString();
+
 private:
     bool ReadRecoveredSig(Consensus::LLMQType llmqType, const uint256& id, CRecoveredSig& ret);
+    void WriteRecoveredSig(CDBBatch& batch, const CRecoveredSig& recSig, uint32_t curTime);
     void RemoveRecoveredSig(CDBBatch& batch, Consensus::LLMQType llmqType, const uint256& id, bool deleteTimeKey);
 };
 
@@ -131,6 +158,7 @@ private:
     FastRandomContext rnd;
 
     int64_t lastCleanupTime{0};
+    int64_t lastStatsLogTime{0};
 
     std::vector<CRecoveredSigsListener*> recoveredSigsListeners;
 
@@ -160,6 +188,9 @@ private:
     void ProcessPendingReconstructedRecoveredSigs();
     bool ProcessPendingRecoveredSigs(CConnman& connman); // called from the worker thread of CSigSharesManager
     void ProcessRecoveredSig(NodeId nodeId, const CRecoveredSig& recoveredSig, const CQuorumCPtr& quorum, CConnman& connman);
+    // signatures must be verified already. Writes all new recSigs to the db in one batch before relaying them and
+    // notifying listeners
+    void ProcessRecoveredSigs(const std::vector<std::tuple<NodeId, CRecoveredSig, CQuorumCPtr>>& recoveredSigs, CConnman& connman);
     void Cleanup(); // called from the worker thread of CSigSharesManager
 
 public:
@@ -176,6 +207,8 @@ public:
 
     bool HasVotedOnId(Consensus::LLMQType llmqType, const uint256& id);
     bool GetVoteForId(Consensus::LLMQType llmqType, const uint256& id, uint256& msgHashRet);
+    // called from the worker thread of CSigSharesManager before it signs
+    void FlushPendingVotes();
 
     std::vector<CQuorumCPtr> GetActiveQuorumSet(Consensus::LLMQType llmqType, int signHeight);
     CQuorumCPtr SelectQuorumForSigning(Consensus::LLMQType llmqType, int signHeight, const uint256& selectionHash);
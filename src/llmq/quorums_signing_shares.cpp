@@ -2,6 +2,7 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "quorums_init.h"
 #include "quorums_signing.h"
 #include "quorums_signing_shares.h"
 #include "quorums_utils.h"
@@ -582,7 +583,8 @@ bool CSigSharesManager::ProcessPendingSigShares(CConnman& connman)
 
     // It's ok to perform insecure batched verification here as we verify against the quorum public key shares,
     // which are not craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, SigShareKey> batchVerifier(false, true);
+    // Shares are sharded per node and the shards are verified in parallel on the BLS worker pool
+    CBLSShardedBatchVerifier<NodeId, SigShareKey> batchVerifier(false, true);
 
     size_t verifyCount = 0;
     for (auto& p : sigSharesByNodes) {
@@ -618,7 +620,7 @@ bool CSigSharesManager::ProcessPendingSigShares(CConnman& connman)
     }
 
     cxxtimer::Timer verifyTimer(true);
-    batchVerifier.Verify();
+    batchVerifier.Verify(blsWorker);
     verifyTimer.stop();
 
     LogPrint("llmq-sigs", "CSigSharesManager::%s -- verified sig shares. count=%d, vt=%d, nodes=%d\n", __func__, verifyCount, verifyTimer.count(), sigSharesByNodes.size());
@@ -1385,6 +1387,13 @@ bool CSigSharesManager::SignPendingSigShares()
         v = std::move(pendingSigns);
     }
 
+    if (v.empty()) {
+        return false;
+    }
+
+    // the votes for these were queued before the signs, so this makes sure they are on disk before we sign
+    quorumSigningManager->FlushPendingVotes();
+
     for (auto& t : v) {
         Sign(std::get<0>(t), std::get<1>(t), std::get<2>(t));
     }
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "messagesigcache.h"
+
+#include "crypto/sha256.h"
+#include "cuckoocache.h"
+#include "random.h"
+#include "script/sigcache.h"
+#include "util.h"
+
+#include <boost/thread.hpp>
+
+namespace {
+
+/** Entries are salted SHA256 hashes, so their words can be used as the cuckoo hashes directly. */
+class MessageSignatureCacheHasher
+{
+public:
+    template <uint8_t hash_select>
+    uint32_t operator()(const uint256& key) const
+    {
+        static_assert(hash_select < 8, "MessageSignatureCacheHasher only has 8 hashes available.");
+        uint32_t u;
+        std::memcpy(&u, key.begin() + 4 * hash_select, 4);
+        return u;
+    }
+};
+
+class CMessageSignatureCache
+{
+private:
+    //! Entries are SHA256(nonce || key id || message hash || signature):
+    uint256 nonce;
+    typedef CuckooCache::cache<uint256, MessageSignatureCacheHasher> map_type;
+    map_type setValid;
+    boost::shared_mutex cs_msgsigcache;
+
+public:
+    CMessageSignatureCache()
+    {
+        GetRandBytes(nonce.begin(), 32);
+    }
+
+    void ComputeEntry(uint256& entry, const CKeyID& keyID, const uint256& hashMessage, const std::vector<unsigned char>& vchSig)
+    {
+        CSHA256().Write(nonce.begin(), 32).Write(keyID.begin(), keyID.size()).Write(hashMessage.begin(), 32).Write(vchSig.data(), vchSig.size()).Finalize(entry.begin());
+    }
+
+    bool Get(const uint256& entry)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_msgsigcache);
+        return setValid.contains(entry, false);
+    }
+
+    void Set(uint256& entry)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(cs_msgsigcache);
+        setValid.insert(entry);
+    }
+
+    uint32_t setup_bytes(size_t n)
+    {
+        return setValid.setup_bytes(n);
+    }
+};
+
+static CMessageSignatureCache messageSignatureCache;
+}
+
+void InitMessageSignatureCache()
+{
+    size_t nMaxCacheSize = std::min(std::max((int64_t)0, GetArg("-maxmsgsigcachesize", DEFAULT_MAX_MSG_SIG_CACHE_SIZE)), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+    size_t nElems = messageSignatureCache.setup_bytes(nMaxCacheSize);
+    LogPrintf("Using %zu MiB out of %zu requested for message signature cache, able to store %zu elements\n",
+            (nElems*sizeof(uint256)) >>20, nMaxCacheSize>>20, nElems);
+}
+
+bool GetCachedMessageSignature(const CKeyID& keyID, const uint256& hashMessage, const std::vector<unsigned char>& vchSig)
+{
+    uint256 entry;
+    messageSignatureCache.ComputeEntry(entry, keyID, hashMessage, vchSig);
+    return messageSignatureCache.Get(entry);
+}
+
+void AddCachedMessageSignature(const CKeyID& keyID, const uint256& hashMessage, const std::vector<unsigned char>& vchSig)
+{
+    uint256 entry;
+    messageSignatureCache.ComputeEntry(entry, keyID, hashMessage, vchSig);
+    messageSignatureCache.Set(entry);
+}
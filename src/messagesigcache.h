@@ -0,0 +1,29 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_MESSAGESIGCACHE_H
+#define BITCOIN_MESSAGESIGCACHE_H
+
+#include "pubkey.h"
+#include "uint256.h"
+
+#include <vector>
+
+/** Default for -maxmsgsigcachesize, in megabytes */
+static const unsigned int DEFAULT_MAX_MSG_SIG_CACHE_SIZE = 4;
+
+/** Size the message signature cache from -maxmsgsigcachesize. */
+void InitMessageSignatureCache();
+
+/**
+ * Salted cuckoo cache of verified message signatures, the CheckStakeSignature
+ * counterpart of the script signature cache. The same ABN and GSC messages are
+ * checked on mempool acceptance, block creation, AntiGPU and every GSC
+ * assessment; each check otherwise costs a compact signature recovery.
+ * Entries are (key id, message hash, signature) triples that verified.
+ */
+bool GetCachedMessageSignature(const CKeyID& keyID, const uint256& hashMessage, const std::vector<unsigned char>& vchSig);
+void AddCachedMessageSignature(const CKeyID& keyID, const uint256& hashMessage, const std::vector<unsigned char>& vchSig);
+
+#endif // BITCOIN_MESSAGESIGCACHE_H
@@ -62,6 +62,97 @@
 uint64_t nLastBlockTx = 0;
 uint64_t nLastBlockSize = 0;
 
+CBlockCandidate blockCandidate;
+
+bool CBlockCandidate::Context::operator==(const Context& other) const
+{
+    return hashTip == other.hashTip &&
+           nLockTimeCutoff == other.nLockTimeCutoff &&
+           nBlockMaxSize == other.nBlockMaxSize &&
+           nMinFeePerK == other.nMinFeePerK &&
+           nReservedSize == other.nReservedSize &&
+           nReservedSigOps == other.nReservedSigOps;
+}
+
+void CBlockCandidate::Connect(CTxMemPool& pool)
+{
+    AssertLockHeld(cs);
+    if (fConnected)
+        return;
+    // Removals need no handler: selected transactions are looked up in the mempool
+    // by every template, and the ones that are gone mark the candidate stale there
+    pool.NotifyEntryAdded.connect([this](CTransactionRef tx) { TransactionAddedToMempool(tx); });
+    fConnected = true;
+}
+
+void CBlockCandidate::TransactionAddedToMempool(const CTransactionRef& tx)
+{
+    LOCK(cs);
+    if (!fValid)
+        return;
+    if (vPending.size() >= MAX_BLOCK_CANDIDATE_PENDING) {
+        // Nobody asked for a template in a long while, select from scratch next time
+        fStale = true;
+        vPending.clear();
+        return;
+    }
+    vPending.push_back(tx->GetHash());
+}
+
+bool CBlockCandidate::IsUsable(const Context& contextIn, int64_t nNow) const
+{
+    if (!fValid || !(context == contextIn))
+        return false;
+    return !fStale || nNow - nTimeSelected < BLOCK_CANDIDATE_REFRESH_SECONDS;
+}
+
+void CBlockCandidate::Reset(const Context& contextIn, int64_t nNow)
+{
+    AssertLockHeld(cs);
+    context = contextIn;
+    fValid = true;
+    fStale = false;
+    nTimeSelected = nNow;
+    vSelected.clear();
+    setSelected.clear();
+    vPending.clear();
+    vRetry.clear();
+}
+
+void CBlockCandidate::Invalidate()
+{
+    LOCK(cs);
+    fValid = false;
+    vSelected.clear();
+    setSelected.clear();
+    vPending.clear();
+    vRetry.clear();
+}
+
+void CBlockCandidate::Add(const uint256& hash)
+{
+    AssertLockHeld(cs);
+    vSelected.push_back(hash);
+    setSelected.insert(hash);
+}
+
+std::vector<uint256> CBlockCandidate::TakePending()
+{
+    AssertLockHeld(cs);
+    // Retried transactions entered the mempool before the pending ones, keep parents first
+    std::vector<uint256> vRet;
+    vRet.swap(vRetry);
+    vRet.insert(vRet.end(), vPending.begin(), vPending.end());
+    vPending.clear();
+    return vRet;
+}
+
+void CBlockCandidate::Retry(const uint256& hash)
+{
+    AssertLockHeld(cs);
+    vRetry.push_back(hash);
+}
+
 class ScoreCompare
 {
 public:
@@ -92,12 +183,14 @@ int64_t UpdateTime(CBlockHeader* pblock, const Consensus::Params& consensusParam
 BlockAssembler::Options::Options() {	
     blockMinFeeRate = CFeeRate(DEFAULT_BLOCK_MIN_TX_FEE);	    
     nBlockMaxSize = DEFAULT_BLOCK_MAX_SIZE;	
+    fUseCandidate = false;
 }
 
 
 BlockAssembler::BlockAssembler(const CChainParams& params, const Options& options) : chainparams(params)	
 {
     blockMinFeeRate = options.blockMinFeeRate;	   
+    fUseCandidate = options.fUseCandidate;
     // Limit size to between 1K and MaxBlockSize()-1K for sanity:	 
     nBlockMaxSize = std::max((unsigned int)1000, std::min((unsigned int)(MaxBlockSize(fDIP0001ActiveAtTip) - 1000), (unsigned int)options.nBlockMaxSize));	
 }
@@ -123,12 +216,14 @@ static BlockAssembler::Options DefaultOptions(const CChainParams& params)
 	{
         options.blockMinFeeRate = CFeeRate(DEFAULT_BLOCK_MIN_TX_FEE);
     }
+    options.fUseCandidate = true;
 	return options;
 }
 
 void BlockAssembler::resetBlock()
 {
     inBlock.clear();
+    unsafeTxs.clear();
     // Reserve space for coinbase tx
     nBlockSize = 1000;
     nBlockSigOps = 100;
@@ -173,7 +268,7 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
 	if (nHeight >= chainparams.GetConsensus().RANDOMX_HEIGHT)
 	{
 		pblock->RandomXKey  = uRandomXKey;
-		pblock->RandomXData = "<rxheader>" + HexStr(vRandomXHeader.begin(), vRandomXHeader.end()) + "</rxheader>";
+		pblock->RandomXData = CRandomXHeader::FromBytes(vRandomXHeader).ToString();
 	}
 
 	// End of RandomX Support
@@ -199,7 +294,10 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
 	std::string sABNLocator;
     int nPackagesSelected = 0;
     int nDescendantsUpdated = 0;
-    addPackageTxs(nPackagesSelected, nDescendantsUpdated);
+    if (fUseCandidate)
+        addCandidateTxs(pindexPrev->GetBlockHash(), nPackagesSelected, nDescendantsUpdated);
+    else
+        addPackageTxs(nPackagesSelected, nDescendantsUpdated);
 
     int64_t nTime1 = GetTimeMicros();
 
@@ -283,6 +381,8 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
 	{
 		if (fDebugSpam)
 			LogPrint("miner", "BibleMiner failed to create new block\n");
+        if (fUseCandidate)
+            blockCandidate.Invalidate();
         return NULL;
     }
     int64_t nTime2 = GetTimeMicros();
@@ -293,6 +393,30 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     return std::move(pblocktemplate);
 }
 
+std::unique_ptr<CBlockTemplate> BlockAssembler::SelectTransactions(const uint256& hashTip, int nHeightIn, int64_t nLockTimeCutoffIn)
+{
+    resetBlock();
+
+    pblocktemplate.reset(new CBlockTemplate());
+    pblock = &pblocktemplate->block;
+    pblock->vtx.emplace_back();
+    pblocktemplate->vTxFees.push_back(-1);
+    pblocktemplate->vTxSigOps.push_back(-1);
+
+    nHeight = nHeightIn;
+    nLockTimeCutoff = nLockTimeCutoffIn;
+
+    LOCK(mempool.cs);
+    int nPackagesSelected = 0;
+    int nDescendantsUpdated = 0;
+    if (fUseCandidate)
+        addCandidateTxs(hashTip, nPackagesSelected, nDescendantsUpdated);
+    else
+        addPackageTxs(nPackagesSelected, nDescendantsUpdated);
+    pblock->hashPrevBlock = hashTip;
+    return std::move(pblocktemplate);
+}
+
 void BlockAssembler::onlyUnconfirmed(CTxMemPool::setEntries& testSet)
 {
     for (CTxMemPool::setEntries::iterator iit = testSet.begin(); iit != testSet.end(); ) {
@@ -353,6 +477,9 @@ int BlockAssembler::UpdatePackagesForAdded(const CTxMemPool::setEntries& already
 {
     int nDescendantsUpdated = 0;
     BOOST_FOREACH(const CTxMemPool::txiter it, alreadyAdded) {
+        // No in-mempool children whose package state could change
+        if (it->GetCountWithDescendants() == 1)
+            continue;
         CTxMemPool::setEntries descendants;
         mempool.CalculateDescendants(it, descendants);
         // Insert all descendants (not yet in block) into the modified set
@@ -403,6 +530,108 @@ void BlockAssembler::SortForBlock(const CTxMemPool::setEntries& package, CTxMemP
     std::sort(sortedEntries.begin(), sortedEntries.end(), CompareTxIterByAncestorCount());
 }
 
+// Templates are requested far more often than the tip changes, and between two
+// requests only a handful of transactions enter the mempool. Instead of running
+// addPackageTxs over the whole mempool every time, reuse the previous selection
+// and append the new arrivals whose mempool parents are all selected already.
+// Arrivals are appended in the order they were accepted, which is a valid block
+// order but not necessarily the ancestor feerate order; anything the shortcut
+// cannot handle marks the candidate stale so the next full selection, at most
+// BLOCK_CANDIDATE_REFRESH_SECONDS later, puts things right. Transactions that are
+// not safe to mine yet are retried by every template instead, as a full selection
+// would skip them as well.
+void BlockAssembler::addCandidateTxs(const uint256& hashTip, int &nPackagesSelected, int &nDescendantsUpdated)
+{
+    AssertLockHeld(mempool.cs);
+
+    CBlockCandidate::Context context;
+    context.hashTip = hashTip;
+    context.nLockTimeCutoff = nLockTimeCutoff;
+    context.nBlockMaxSize = nBlockMaxSize;
+    context.nMinFeePerK = blockMinFeeRate.GetFeePerK();
+    context.nReservedSize = nBlockSize;
+    context.nReservedSigOps = nBlockSigOps;
+    int64_t nNow = GetTime();
+
+    LOCK(blockCandidate.cs);
+    blockCandidate.Connect(mempool);
+
+    if (!blockCandidate.IsUsable(context, nNow)) {
+        size_t nFirstTx = pblock->vtx.size();
+        addPackageTxs(nPackagesSelected, nDescendantsUpdated);
+        blockCandidate.Reset(context, nNow);
+        for (size_t i = nFirstTx; i < pblock->vtx.size(); i++)
+            blockCandidate.Add(pblock->vtx[i]->GetHash());
+        // Nothing else would look at the skipped transactions again until the next full
+        // selection, which might never come when they are the only thing missing
+        std::vector<CTxMemPool::txiter> vUnsafe(unsafeTxs.begin(), unsafeTxs.end());
+        std::sort(vUnsafe.begin(), vUnsafe.end(), [](const CTxMemPool::txiter& a, const CTxMemPool::txiter& b) {
+            return a->GetCountWithAncestors() < b->GetCountWithAncestors();
+        });
+        for (const CTxMemPool::txiter& it : vUnsafe)
+            blockCandidate.Retry(it->GetTx().GetHash());
+        return;
+    }
+
+    for (const uint256& hash : blockCandidate.GetSelected()) {
+        CTxMemPool::txiter it = mempool.mapTx.find(hash);
+        if (it == mempool.mapTx.end()) {
+            // Replaced or expired; its in-mempool descendants went with it
+            blockCandidate.MarkStale();
+            continue;
+        }
+        AddToBlock(it);
+    }
+
+    // Transactions put back for retry by this template
+    std::unordered_set<uint256, StaticSaltedHasher> setRetry;
+    for (const uint256& hash : blockCandidate.TakePending()) {
+        CTxMemPool::txiter it = mempool.mapTx.find(hash);
+        if (it == mempool.mapTx.end() || blockCandidate.IsSelected(hash) || setRetry.count(hash))
+            continue;
+        if (it->GetModifiedFee() < blockMinFeeRate.GetFee(it->GetTxSize())) {
+            // Would not be selected on its own either; a descendant paying for it
+            // finds its parent unselected below
+            continue;
+        }
+
+        // Waiting for a parent that is not safe to mine yet is not a reason for a full
+        // selection, which could not do better
+        bool fParentsSelected = true;
+        bool fParentsRetried = true;
+        for (const CTxMemPool::txiter& parent : mempool.GetMemPoolParents(it)) {
+            const uint256& parentHash = parent->GetTx().GetHash();
+            if (!blockCandidate.IsSelected(parentHash)) {
+                fParentsSelected = false;
+                fParentsRetried &= setRetry.count(parentHash) != 0;
+            }
+        }
+        if (!fParentsSelected) {
+            if (!fParentsRetried)
+                blockCandidate.MarkStale();
+            blockCandidate.Retry(hash);
+            setRetry.insert(hash);
+            continue;
+        }
+        if (!TestPackage(it->GetTxSize(), it->GetSigOpCount())) {
+            blockCandidate.MarkStale();
+            continue;
+        }
+        CTxMemPool::setEntries package;
+        package.insert(it);
+        if (!TestPackageTransactions(package)) {
+            // Not IS-locked (or not final) yet, a full selection would skip it too
+            blockCandidate.Retry(hash);
+            setRetry.insert(hash);
+            continue;
+        }
+
+        AddToBlock(it);
+        blockCandidate.Add(hash);
+        ++nPackagesSelected;
+    }
+}
+
 // This transaction selection algorithm orders the mempool based
 // on feerate of a transaction including all unconfirmed ancestors.
 // Since we don't remove transactions from the mempool as we select them
@@ -506,15 +735,21 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
         }
 
         CTxMemPool::setEntries ancestors;
-        uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
-        std::string dummy;
-        mempool.CalculateMemPoolAncestors(*iter, ancestors, nNoLimit, nNoLimit, nNoLimit, nNoLimit, dummy, false);
-
-        onlyUnconfirmed(ancestors);
+        // Most packages are a single transaction without unconfirmed parents
+        // (GSC and ABN transmissions, plain payments); the cached ancestor
+        // state already says so, no need to walk the mempool.
+        if (iter->GetCountWithAncestors() > 1) {
+            uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
+            std::string dummy;
+            mempool.CalculateMemPoolAncestors(*iter, ancestors, nNoLimit, nNoLimit, nNoLimit, nNoLimit, dummy, false);
+            onlyUnconfirmed(ancestors);
+        }
         ancestors.insert(iter);
 
         // Test if all tx's are Final and safe
         if (!TestPackageTransactions(ancestors)) {
+            if (fUseCandidate)
+                unsafeTxs.insert(ancestors.begin(), ancestors.end());
             if (fUsingModified) {
                 mapModifiedTx.get<ancestor_score>().erase(modit);
                 failedTx.insert(iter);
@@ -525,14 +760,20 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
         // This transaction will make it in; reset the failed counter.
         nConsecutiveFailed = 0;
 
-        // Package can be added. Sort the entries in a valid order.
-        std::vector<CTxMemPool::txiter> sortedEntries;
-        SortForBlock(ancestors, iter, sortedEntries);
-
-        for (size_t i=0; i<sortedEntries.size(); ++i) {
-            AddToBlock(sortedEntries[i]);
-            // Erase from the modified set, if present
-            mapModifiedTx.erase(sortedEntries[i]);
+        if (ancestors.size() == 1) {
+            AddToBlock(iter);
+            if (fUsingModified)
+                mapModifiedTx.erase(iter);
+        } else {
+            // Package can be added. Sort the entries in a valid order.
+            std::vector<CTxMemPool::txiter> sortedEntries;
+            SortForBlock(ancestors, iter, sortedEntries);
+
+            for (size_t i=0; i<sortedEntries.size(); ++i) {
+                AddToBlock(sortedEntries[i]);
+                // Erase from the modified set, if present
+                mapModifiedTx.erase(sortedEntries[i]);
+            }
         }
 
         ++nPackagesSelected;
@@ -542,7 +783,7 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
     }
 }
 
-void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce)
+void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce, std::vector<uint256>* pvCoinbaseBranch)
 {
     // Update nExtraNonce
     static uint256 hashPrevBlock;
@@ -552,13 +793,25 @@ void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned
         hashPrevBlock = pblock->hashPrevBlock;
     }
     ++nExtraNonce;
+    SetExtraNonce(pblock, pindexPrev, nExtraNonce, pvCoinbaseBranch);
+}
+
+void SetExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int nExtraNonce, std::vector<uint256>* pvCoinbaseBranch)
+{
     unsigned int nHeight = pindexPrev->nHeight+1; // Height first in coinbase required for block.version=2
     CMutableTransaction txCoinbase(*pblock->vtx[0]);
     txCoinbase.vin[0].scriptSig = (CScript() << nHeight << CScriptNum(nExtraNonce)) + COINBASE_FLAGS;
     assert(txCoinbase.vin[0].scriptSig.size() <= 100);
 
     pblock->vtx[0] = MakeTransactionRef(std::move(txCoinbase));
-    pblock->hashMerkleRoot = BlockMerkleRoot(*pblock);
+    if (pvCoinbaseBranch) {
+        // Only the coinbase changed, so just its path to the root needs rehashing
+        if (pvCoinbaseBranch->empty() && pblock->vtx.size() > 1)
+            *pvCoinbaseBranch = BlockMerkleBranch(*pblock, 0);
+        pblock->hashMerkleRoot = BlockMerkleRootFromCoinbaseBranch(*pblock, *pvCoinbaseBranch);
+    } else {
+        pblock->hashMerkleRoot = BlockMerkleRoot(*pblock);
+    }
 }
 
 
@@ -569,15 +822,129 @@ void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned
 //                                                                          //
 //////////////////////////////////////////////////////////////////////////////
 
-void UpdateHashesPerSec(double& nHashesDone)
+CMiningCoordinator miningCoordinator;
+
+void CMiningCoordinator::Start(int nThreadsIn, const boost::shared_ptr<CReserveScript>& coinbaseScriptIn)
 {
-	// Update HashesPerSec
-	nHashCounter += nHashesDone;
-	nHashesDone = 0;
-	dHashesPerSec = 1000.0 * nHashCounter / (GetTimeMillis() - nHPSTimerStart);
+	LOCK(cs);
+	nThreads = nThreadsIn;
+	coinbaseScript = coinbaseScriptIn;
+	pblocktemplate.reset();
+	pindexPrev = NULL;
+	// Start from a different extranonce than a previous run paying to the same script
+	nExtraNonceBase = GetAdjustedTime();
+	vThreadHashes.assign(nThreadsIn, 0);
+	nHashCounter = 0;
+	dHashesPerSec = 0;
+	nHPSTimerStart = GetTimeMillis();
+}
+
+void CMiningCoordinator::Stop()
+{
+	LOCK(cs);
+	nThreads = 0;
+	coinbaseScript.reset();
+	pblocktemplate.reset();
+	pindexPrev = NULL;
+	vThreadHashes.clear();
+	dHashesPerSec = 0;
+}
+
+bool CMiningCoordinator::IsTemplateOutdated() const
+{
+	AssertLockHeld(cs);
+	if (!pblocktemplate || pindexPrev == NULL || pindexPrev != chainActive.Tip())
+		return true;
+	return mempool.GetTransactionsUpdated() != nTransactionsUpdated && GetTime() - nTimeCreated > MINER_TEMPLATE_REFRESH_SECONDS;
+}
+
+std::shared_ptr<const CBlockTemplate> CMiningCoordinator::GetTemplate(const CChainParams& chainparams, const CBlockIndex*& pindexPrevRet, uint64_t& nTemplateIdRet)
+{
+	LOCK(cs);
+	if (IsTemplateOutdated())
+	{
+		// Throw an error if no script was provided.  This can happen
+		// due to some internal error but also if the keypool is empty.
+		// In the latter case, already the pointer is NULL.
+		if (!coinbaseScript || coinbaseScript->reserveScript.empty())
+			throw std::runtime_error("No coinbase script available (mining requires a wallet)");
+
+		unsigned int nTransactionsUpdatedLast = mempool.GetTransactionsUpdated();
+		uint256 uRXKey = uint256S("0x01");
+		std::vector<unsigned char> vchRXHeader = ParseHex("00");
+		std::unique_ptr<CBlockTemplate> pnewtemplate(BlockAssembler(chainparams).CreateNewBlock(coinbaseScript->reserveScript, "", uRXKey, vchRXHeader));
+		if (!pnewtemplate.get())
+			return nullptr;
+		// Every thread only changes the coinbase, so they can all share its merkle branch
+		if (pnewtemplate->block.vtx.size() > 1)
+			pnewtemplate->vCoinbaseMerkleBranch = BlockMerkleBranch(pnewtemplate->block, 0);
+
+		const CBlockIndex* pindexTemplate = NULL;
+		{
+			LOCK(cs_main);
+			BlockMap::const_iterator mi = mapBlockIndex.find(pnewtemplate->block.hashPrevBlock);
+			if (mi != mapBlockIndex.end())
+				pindexTemplate = mi->second;
+		}
+		if (pindexTemplate == NULL)
+			return nullptr;
+
+		pblocktemplate = std::move(pnewtemplate);
+		pindexPrev = pindexTemplate;
+		nTransactionsUpdated = nTransactionsUpdatedLast;
+		nTimeCreated = GetTime();
+		++nTemplateId;
+	}
+	pindexPrevRet = pindexPrev;
+	nTemplateIdRet = nTemplateId;
+	return pblocktemplate;
+}
+
+bool CMiningCoordinator::IsOutdated(uint64_t nTemplateIdIn) const
+{
+	LOCK(cs);
+	return nTemplateIdIn != nTemplateId || IsTemplateOutdated();
+}
+
+unsigned int CMiningCoordinator::GetExtraNonce(int iThread, unsigned int nRound) const
+{
+	LOCK(cs);
+	return nExtraNonceBase + nRound * std::max(nThreads, 1) + iThread;
+}
+
+void CMiningCoordinator::KeepScript()
+{
+	LOCK(cs);
+	if (coinbaseScript)
+		coinbaseScript->KeepScript();
+}
+
+void CMiningCoordinator::AddHashes(int iThread, double nHashes)
+{
+	LOCK(cs);
+	if (iThread >= 0 && iThread < (int)vThreadHashes.size())
+		vThreadHashes[iThread] += nHashes;
+	nHashCounter += nHashes;
+	dHashesPerSec = 1000.0 * nHashCounter / std::max(GetTimeMillis() - nHPSTimerStart, (int64_t)1);
 	nBibleMinerPulse++;
 }
 
+std::vector<double> CMiningCoordinator::GetThreadHashesPerSec() const
+{
+	LOCK(cs);
+	std::vector<double> vRet;
+	int64_t nElapsed = std::max(GetTimeMillis() - nHPSTimerStart, (int64_t)1);
+	for (double nHashes : vThreadHashes)
+		vRet.push_back(1000.0 * nHashes / nElapsed);
+	return vRet;
+}
+
+void UpdateHashesPerSec(int iThreadID, double& nHashesDone)
+{
+	miningCoordinator.AddHashes(iThreadID, nHashesDone);
+	nHashesDone = 0;
+}
+
 bool PeersExist()
 {
 	 int iConCount = (int)g_connman->GetNodeCount(CConnman::CONNECTIONS_ALL);
@@ -621,8 +988,9 @@ void static BibleMiner(const CChainParams& chainparams, int iThreadID, int iFeat
     int64_t nThreadStart = GetTimeMillis();
 	int64_t nLastGUI = GetAdjustedTime() - 30;
 	int64_t nLastMiningBreak = 0;
-	unsigned int nExtraNonce = 0;
 	double nHashesDone = 0;
+	uint64_t nLastTemplateId = 0;
+	unsigned int nRound = 0;
 	
 	// This allows the miner to dictate how much sleep will occur when distributed computing is enabled.  This will let PODC use the maximum CPU time.  NOTE: The default is 200ms per 256 hashes.
 	double dMinerSleep = cdbl(GetArg("-minersleep", "325"), 0);
@@ -630,21 +998,12 @@ void static BibleMiner(const CChainParams& chainparams, int iThreadID, int iFeat
 	double dJackrabbitStart = cdbl(GetArg("-jackrabbitstart", "0"), 0);
     RenameThread("dac-miner");
 				
-    boost::shared_ptr<CReserveScript> coinbaseScript;
-    GetMainSignals().ScriptForMining(coinbaseScript);
 	int iStart = rand() % 1000;
 	MilliSleep(iStart);
 
 recover:
 	
     try {
-        // Throw an error if no script was provided.  This can happen
-        // due to some internal error but also if the keypool is empty.
-        // In the latter case, already the pointer is NULL.
-        if (!coinbaseScript || coinbaseScript->reserveScript.empty())
-            throw std::runtime_error("No coinbase script available (mining requires a wallet)");
-
-		
         while (true) 
 		{
 			bool fChainEmpty = (chainActive.Tip() == NULL || chainActive.Tip()->nHeight < 100);
@@ -665,44 +1024,43 @@ recover:
             }
 			
 
-            //
-            // Create new block
-            //
-            unsigned int nTransactionsUpdatedLast = mempool.GetTransactionsUpdated();
-            CBlockIndex* pindexPrev = chainActive.Tip();
-            if(!pindexPrev) break;
-			bool fRandomX = (pindexPrev->nHeight >= chainparams.GetConsensus().RANDOMX_HEIGHT);
-
 			if (!fProd && mempool.size() == 0 && GetSporkDouble("SLEEP_DURING_EMPTY_BLOCKS", 0) == 1)
                 MilliSleep(1000 * 60 * 7);
-           
-			// Create Evo block
-			uint256 uRXKey = uint256S("0x01");
-			std::vector<unsigned char> vchRXHeader = ParseHex("00");
-	
-			std::unique_ptr<CBlockTemplate> pblocktemplate(BlockAssembler(Params()).CreateNewBlock(coinbaseScript->reserveScript, "", uRXKey, vchRXHeader));
-			if (!pblocktemplate.get())
+
+            //
+            // Get the shared block template, built once per tip/mempool change for all threads
+            //
+			const CBlockIndex* pindexPrev = NULL;
+			uint64_t nTemplateId = 0;
+			std::shared_ptr<const CBlockTemplate> pblocktemplate = miningCoordinator.GetTemplate(chainparams, pindexPrev, nTemplateId);
+			if (!pblocktemplate)
             {
 				MilliSleep(15000);
 				LogPrint("miner", "No block to mine %f", iThreadID);
 				goto recover;
             }
+			bool fRandomX = (pindexPrev->nHeight >= chainparams.GetConsensus().RANDOMX_HEIGHT);
 
-			CBlock *pblock = &pblocktemplate->block;
-			
-			int iStart = rand() % 65536;
-			unsigned int nExtraNonce = GetAdjustedTime() + iStart + iThreadID;
-			
-            IncrementExtraNonce(pblock, pindexPrev, nExtraNonce);
+			CBlock block = pblocktemplate->block;
+			CBlock *pblock = &block;
+			std::vector<uint256> vCoinbaseMerkleBranch = pblocktemplate->vCoinbaseMerkleBranch;
+			UpdateTime(pblock, chainparams.GetConsensus(), pindexPrev);
+
+			// Search this thread's own slice of the extranonce space, a new one for every pass over the template
+			if (nTemplateId != nLastTemplateId)
+			{
+				nLastTemplateId = nTemplateId;
+				nRound = 0;
+			}
+            SetExtraNonce(pblock, pindexPrev, miningCoordinator.GetExtraNonce(iThreadID, nRound++), &vCoinbaseMerkleBranch);
 			nHashesDone++;
-			UpdateHashesPerSec(nHashesDone);
+			UpdateHashesPerSec(iThreadID, nHashesDone);
 			if (fDebugSpam)
 				LogPrint("miner", "SoloMiner -- Running miner with %u transactions in block (%u bytes)\n", 
 				     pblock->vtx.size(), ::GetSerializeSize(*pblock, SER_NETWORK, PROTOCOL_VERSION));
 		    //
             // Search
             //
-            int64_t nStart = GetTime();
             arith_uint256 hashTarget = arith_uint256().SetCompact(pblock->nBits);
 			bool f7000;
 			bool f8000;
@@ -734,7 +1092,7 @@ recover:
 								LogPrint("miner", "\nblock rejected.");
 								MilliSleep(15000);
 							}
-							coinbaseScript->KeepScript();
+							miningCoordinator.KeepScript();
 							// In regression test mode, stop mining after a block is found. This
 							// allows developers to controllably generate a block on demand.
 							if (chainparams.MineBlocksOnDemand())
@@ -760,7 +1118,7 @@ recover:
 						if (nElapsed > 5)
 						{
 							nLastGUI = GetAdjustedTime();
-							UpdateHashesPerSec(nHashesDone);
+							UpdateHashesPerSec(iThreadID, nHashesDone);
 							bool fNonce = CheckNonce(f9000, pblock->nNonce, pindexPrev->nHeight, pindexPrev->nTime, pblock->GetBlockTime(), consensusParams);
 							if (!fNonce)
 							{
@@ -777,7 +1135,7 @@ recover:
 					}
 				}
 
-				UpdateHashesPerSec(nHashesDone);
+				UpdateHashesPerSec(iThreadID, nHashesDone);
 				// Check for stop or if block needs to be rebuilt
 				boost::this_thread::interruption_point();
 				// Regtest mode doesn't require peers
@@ -785,10 +1143,8 @@ recover:
 				if (!PeersExist() && chainparams.MiningRequiresPeers())
 					 break;
 
-				if (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > 60)
-					break;
-		
-				if (pindexPrev != chainActive.Tip() || pindexPrev==NULL || chainActive.Tip()==NULL)
+				// New tip, or mempool changes older than MINER_TEMPLATE_REFRESH_SECONDS
+				if (miningCoordinator.IsOutdated(nTemplateId))
 					break;
 		
 				if (pblock->nNonce >= 0x9FFF)
@@ -844,6 +1200,7 @@ void GenerateCoins(bool fGenerate, int nThreads, const CChainParams& chainparams
         delete minerThreads;
         minerThreads = NULL;
 		LogPrintf("Destroyed all miner threads %f", GetAdjustedTime());
+		miningCoordinator.Stop();
 
 		// We must be very careful here with RandomX, as we have one VM running per mining thread, so we need to let these threads exit
 
@@ -858,6 +1215,11 @@ void GenerateCoins(bool fGenerate, int nThreads, const CChainParams& chainparams
  	if (msSessionID.empty())
 		msSessionID = GetRandHash().GetHex();
 
+	// One coinbase script for all threads; they are kept apart by their extranonce
+    boost::shared_ptr<CReserveScript> coinbaseScript;
+    GetMainSignals().ScriptForMining(coinbaseScript);
+	miningCoordinator.Start(nThreads, coinbaseScript);
+
 	int iBibleNumber = 0;			
     for (int i = 0; i < nThreads; i++)
 	{
@@ -867,9 +1229,6 @@ void GenerateCoins(bool fGenerate, int nThreads, const CChainParams& chainparams
 	}
 	iMinerThreadCount = nThreads;
 
-	// Maintain the HashPS
-	nHPSTimerStart = GetTimeMillis();
-	nHashCounter = 0;
 	LogPrintf(" ** Started %f BibleMiner threads. ** \r\n",(double)nThreads);
 }
 
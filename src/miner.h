@@ -7,10 +7,14 @@
 #define BITCOIN_MINER_H
 
 #include "primitives/block.h"
+#include "saltedhasher.h"
+#include "sync.h"
 #include "txmempool.h"
 
 #include <stdint.h>
 #include <memory>
+#include <unordered_set>
+#include <boost/shared_ptr.hpp>
 #include "boost/multi_index_container.hpp"
 #include "boost/multi_index/ordered_index.hpp"
 
@@ -18,12 +22,19 @@ class CBlockIndex;
 class CChainParams;
 class CConnman;
 class CReserveKey;
+class CReserveScript;
 class CScript;
 class CWallet;
 
 namespace Consensus { struct Params; };
 
 static const bool DEFAULT_PRINTPRIORITY = false;
+/** Minimum time between two full transaction selections on the same tip once the candidate fell behind the mempool */
+static const int64_t BLOCK_CANDIDATE_REFRESH_SECONDS = 5;
+/** Mempool arrivals queued for the candidate between two templates before it is marked stale instead */
+static const size_t MAX_BLOCK_CANDIDATE_PENDING = 100000;
+/** Age after which the internal miner rebuilds its template when the mempool changed */
+static const int64_t MINER_TEMPLATE_REFRESH_SECONDS = 60;
 
 void GenerateCoins(bool fGenerate, int nThreads, const CChainParams& chainparams);
 bool CreateBlockForStratum(std::string sAddress, uint256 uRandomXKey, std::vector<unsigned char> vRandomXHeader, std::string& sError, CBlock& blockX);
@@ -36,8 +47,55 @@ struct CBlockTemplate
     uint32_t nPrevBits; // nBits of previous block (for subsidy calculation)
     std::vector<CTxOut> voutMasternodePayments; // masternode payment
     std::vector<CTxOut> voutSuperblockPayments; // superblock payment
+    std::vector<uint256> vCoinbaseMerkleBranch; // set where the coinbase of a template is rolled repeatedly (internal miner), only valid while the non-coinbase transactions are unchanged
 };
 
+/**
+ * Shares one block template between the internal miner threads. The first thread
+ * asking for work after the tip changed (or after the mempool changed and the
+ * template is older than MINER_TEMPLATE_REFRESH_SECONDS) builds it; the others
+ * copy it. Each thread then searches its own slice of the extranonce space, so
+ * the threads never hash the same header, and reports its hashes here.
+ */
+class CMiningCoordinator
+{
+private:
+    mutable CCriticalSection cs;
+    int nThreads;
+    boost::shared_ptr<CReserveScript> coinbaseScript;
+    std::shared_ptr<const CBlockTemplate> pblocktemplate;
+    const CBlockIndex* pindexPrev;
+    unsigned int nTransactionsUpdated;
+    int64_t nTimeCreated;
+    uint64_t nTemplateId;
+    unsigned int nExtraNonceBase;
+    std::vector<double> vThreadHashes;
+
+    bool IsTemplateOutdated() const;
+
+public:
+    CMiningCoordinator() : nThreads(0), pindexPrev(nullptr), nTransactionsUpdated(0), nTimeCreated(0), nTemplateId(0), nExtraNonceBase(0) {}
+
+    void Start(int nThreadsIn, const boost::shared_ptr<CReserveScript>& coinbaseScriptIn);
+    void Stop();
+
+    /** Return the current template, building a new one if needed. Returns null if
+     *  no template could be created. */
+    std::shared_ptr<const CBlockTemplate> GetTemplate(const CChainParams& chainparams, const CBlockIndex*& pindexPrevRet, uint64_t& nTemplateIdRet);
+    /** Whether the template nTemplateIdIn should be replaced by a newer one */
+    bool IsOutdated(uint64_t nTemplateIdIn) const;
+    /** The extranonce a thread uses for its nRound-th pass over a template */
+    unsigned int GetExtraNonce(int iThread, unsigned int nRound) const;
+    /** Keep the key a found block paid to */
+    void KeepScript();
+
+    void AddHashes(int iThread, double nHashes);
+    /** Hashes per second of each thread since the miner started */
+    std::vector<double> GetThreadHashesPerSec() const;
+};
+
+extern CMiningCoordinator miningCoordinator;
+
 // Container for tracking updates to ancestor feerate as we include (parent)
 // transactions in a block
 struct CTxMemPoolModifiedEntry {
@@ -136,6 +194,77 @@ struct update_for_parent_inclusion
     CTxMemPool::txiter iter;
 };
 
+/**
+ * Transaction selection for the current tip, shared by the BlockAssemblers that
+ * opt in (internal miner, getblocktemplate, stratum). Transactions entering the
+ * mempool are queued; the next template appends them to the previous selection if
+ * their mempool parents are already selected and they fit. The full ancestor feerate
+ * selection (addPackageTxs) only runs again on a new tip, when the block limits or
+ * the space taken by quorum commitments change, or, at most every
+ * BLOCK_CANDIDATE_REFRESH_SECONDS, after a selected transaction left the mempool or an
+ * arrival could not be appended. Transactions that are in the mempool but not safe to
+ * mine yet (not IS-locked, not final) are kept and retried by every template until they
+ * are selected or leave the mempool.
+ *
+ * All members are guarded by cs, which is taken after mempool.cs.
+ */
+class CBlockCandidate
+{
+public:
+    /** Everything the selection depends on besides the mempool */
+    struct Context {
+        uint256 hashTip;
+        int64_t nLockTimeCutoff;
+        unsigned int nBlockMaxSize;
+        CAmount nMinFeePerK;
+        uint64_t nReservedSize;
+        unsigned int nReservedSigOps;
+
+        bool operator==(const Context& other) const;
+    };
+
+    CCriticalSection cs;
+
+private:
+    bool fConnected;
+    bool fValid;
+    bool fStale;
+    int64_t nTimeSelected;
+    Context context;
+    // Selected txids in block order
+    std::vector<uint256> vSelected;
+    std::unordered_set<uint256, StaticSaltedHasher> setSelected;
+    // Txids that entered the mempool since the last template
+    std::vector<uint256> vPending;
+    // Txids in the mempool that were not safe to mine yet, in a valid block order
+    std::vector<uint256> vRetry;
+
+    void TransactionAddedToMempool(const CTransactionRef& tx);
+
+public:
+    CBlockCandidate() : fConnected(false), fValid(false), fStale(false), nTimeSelected(0) {}
+
+    /** Start listening to the mempool, the first time a template uses the candidate */
+    void Connect(CTxMemPool& pool);
+    /** Whether the selection can be extended for a block in this context */
+    bool IsUsable(const Context& contextIn, int64_t nNow) const;
+    /** Start a new, empty selection for a block in this context */
+    void Reset(const Context& contextIn, int64_t nNow);
+    /** Drop the selection, so the next template does a full selection */
+    void Invalidate();
+    void MarkStale() { fStale = true; }
+
+    void Add(const uint256& hash);
+    bool IsSelected(const uint256& hash) const { return setSelected.count(hash) != 0; }
+    const std::vector<uint256>& GetSelected() const { return vSelected; }
+    /** Return and forget the transactions to retry and the ones that entered the mempool since the last call */
+    std::vector<uint256> TakePending();
+    /** Try the transaction again in the next template */
+    void Retry(const uint256& hash);
+};
+
+extern CBlockCandidate blockCandidate;
+
 /** Generate a new block, without valid proof-of-work */
 class BlockAssembler
 {
@@ -148,6 +277,7 @@ private:
     // Configuration parameters for the block size
     unsigned int nBlockMaxSize;
     CFeeRate blockMinFeeRate;
+    bool fUseCandidate;
 
     // Information on the current status of the block
     uint64_t nBlockSize;
@@ -155,6 +285,8 @@ private:
     unsigned int nBlockSigOps;
     CAmount nFees;
     CTxMemPool::setEntries inBlock;
+    // Packages addPackageTxs skipped because TestPackageTransactions failed (only with fUseCandidate)
+    CTxMemPool::setEntries unsafeTxs;
 
     // Chain context for the block
     int nHeight;
@@ -166,6 +298,8 @@ public:
         Options();
         size_t nBlockMaxSize;
         CFeeRate blockMinFeeRate;
+        // Extend the shared CBlockCandidate instead of selecting from scratch every time
+        bool fUseCandidate;
     };
 
     BlockAssembler(const CChainParams& params);
@@ -173,6 +307,10 @@ public:
 
     /** Construct a new block template with coinbase to scriptPubKeyIn */
 	std::unique_ptr<CBlockTemplate> CreateNewBlock(const CScript& scriptPubKeyIn, std::string sPoolMiningPublicKey, uint256 uRandomXKey, std::vector<unsigned char> vRandomXHeader);
+
+    /** Only select the mempool transactions for a block on top of hashTip, behind a
+     *  placeholder coinbase and without validity checks (for the benchmarks) */
+    std::unique_ptr<CBlockTemplate> SelectTransactions(const uint256& hashTip, int nHeightIn, int64_t nLockTimeCutoffIn);
   
 private:
     // utility functions
@@ -182,6 +320,9 @@ private:
     void AddToBlock(CTxMemPool::txiter iter);
 
     // Methods for how to add transactions to a block.
+    /** Reuse the block candidate's selection and append the transactions that arrived since,
+      * falling back to addPackageTxs (and saving its result) when the candidate is not usable */
+    void addCandidateTxs(const uint256& hashTip, int &nPackagesSelected, int &nDescendantsUpdated);
     /** Add transactions based on feerate including unconfirmed ancestors
       * Increments nPackagesSelected / nDescendantsUpdated with corresponding
       * statistics from the package selection (for logging statistics). */
@@ -208,8 +349,11 @@ private:
     int UpdatePackagesForAdded(const CTxMemPool::setEntries& alreadyAdded, indexed_modified_transaction_set &mapModifiedTx);
 };
 
-/** Modify the extranonce in a block */
-void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce);
+/** Modify the extranonce in a block. With pvCoinbaseBranch the merkle root is updated
+ *  from the coinbase branch, which is computed on the first call and reused after. */
+void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce, std::vector<uint256>* pvCoinbaseBranch = NULL);
+/** Put the given extranonce in the coinbase and update the merkle root, like IncrementExtraNonce */
+void SetExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int nExtraNonce, std::vector<uint256>* pvCoinbaseBranch = NULL);
 int64_t UpdateTime(CBlockHeader* pblock, const Consensus::Params& consensusParams, const CBlockIndex* pindexPrev);
 
 #endif // BITCOIN_MINER_H
@@ -33,7 +33,17 @@ std::string ExtractXML2(std::string XMLdata, std::string key, std::string key_en
 }
 */
 
-//static std::mutex cs_rxhasher;
+void CBlockHeader::GetHashPreimage(unsigned char* preimage) const
+{
+    // Same bytes as serializing the legacy header fields
+    WriteLE32(preimage, nVersion);
+    memcpy(preimage + 4, hashPrevBlock.begin(), 32);
+    memcpy(preimage + 36, hashMerkleRoot.begin(), 32);
+    WriteLE32(preimage + 68, nTime);
+    WriteLE32(preimage + 72, nBits);
+    WriteLE32(preimage + 76, nNonce);
+}
+
 uint256 CBlockHeader::GetHash() const
 {
 	/*
@@ -44,7 +54,6 @@ uint256 CBlockHeader::GetHash() const
 		// This is so our miners may earn a dual revenue stream (RandomX coins + DAC Coins).
 		// The equation is:  BlakeHash(Previous_DAC_Hash + RandomX_Hash(RandomX_Coin_Header)) < Current_DAC_Block_Difficulty
 		// **********************************************************************************************************************************************************************************
-		// std::unique_lock<std::mutex> lock(cs_rxhasher);
 		std::vector<unsigned char> vch(160);
 		CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION, vch, 0);
 		std::string randomXBlockHeader = ExtractXML2(RandomXData, "<rxheader>", "</rxheader>");
@@ -53,15 +62,23 @@ uint256 CBlockHeader::GetHash() const
 		ss << hashPrevBlock << uRXMined;
 		return HashBlake((const char *)vch.data(), (const char *)vch.data() + vch.size());
 	}
-	else
-	{
 	*/
-		// Legacy Hashes (Before consensusParams.RANDOMX_HEIGHT):
-		std::vector<unsigned char> vch(80);
-		CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION, vch, 0);
-		ss << nVersion << hashPrevBlock << hashMerkleRoot << nTime << nBits << nNonce;
-		return HashX11((const char *)vch.data(), (const char *)vch.data() + vch.size());
-	//}
+	// Legacy Hashes (Before consensusParams.RANDOMX_HEIGHT):
+	unsigned char preimage[HASH_PREIMAGE_SIZE];
+	GetHashPreimage(preimage);
+	return HashX11(preimage, preimage + sizeof(preimage));
+}
+
+std::vector<uint256> GetBlockHeaderHashes(const std::vector<CBlockHeader>& headers)
+{
+    // Lay the preimages out back to back
+    static const size_t nSize = CBlockHeader::HASH_PREIMAGE_SIZE;
+    std::vector<unsigned char> vch(headers.size() * nSize);
+    for (size_t i = 0; i < headers.size(); i++)
+        headers[i].GetHashPreimage(vch.data() + i * nSize);
+    std::vector<uint256> vHashes(headers.size());
+    HashX11Batch(vch.data(), nSize, headers.size(), vHashes.data());
+    return vHashes;
 }
 
 /*
@@ -73,11 +90,75 @@ uint256 CBlockHeader::GetHashBible() const
 
 
 
+static const std::string RX_HEADER_OPEN = "<rxheader>";
+static const std::string RX_HEADER_CLOSE = "</rxheader>";
+
+static bool IsLowerHexString(const std::string& str, size_t nBegin, size_t nEnd)
+{
+    for (size_t i = nBegin; i < nEnd; i++) {
+        char c = str[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+            return false;
+    }
+    return true;
+}
+
+CRandomXHeader CRandomXHeader::FromString(const std::string& strData)
+{
+    CRandomXHeader rx;
+    if (strData.empty())
+        return rx;
+
+    // Canonical form, as produced by the miner: "<rxheader>" + lowercase hex + "</rxheader>"
+    size_t nOverhead = RX_HEADER_OPEN.size() + RX_HEADER_CLOSE.size();
+    if (strData.size() >= nOverhead && (strData.size() - nOverhead) % 2 == 0 &&
+        strData.compare(0, RX_HEADER_OPEN.size(), RX_HEADER_OPEN) == 0 &&
+        strData.compare(strData.size() - RX_HEADER_CLOSE.size(), RX_HEADER_CLOSE.size(), RX_HEADER_CLOSE) == 0 &&
+        IsLowerHexString(strData, RX_HEADER_OPEN.size(), strData.size() - RX_HEADER_CLOSE.size())) {
+        rx.nEncoding = RX_ENCODING_BINARY;
+        rx.vchHeader = ParseHex(strData.substr(RX_HEADER_OPEN.size(), strData.size() - nOverhead));
+        return rx;
+    }
+
+    // Anything else is kept verbatim; the hashed bytes are whatever ExtractXML + ParseHex yields
+    rx.nEncoding = RX_ENCODING_LEGACY;
+    rx.strLegacy = strData;
+    std::string::size_type nOpen = strData.find(RX_HEADER_OPEN);
+    if (nOpen != std::string::npos) {
+        std::string::size_type nClose = strData.find(RX_HEADER_CLOSE, nOpen + 3);
+        if (nClose != std::string::npos && nClose >= nOpen + RX_HEADER_OPEN.size())
+            rx.vchHeader = ParseHex(strData.substr(nOpen + RX_HEADER_OPEN.size(), nClose - nOpen - RX_HEADER_OPEN.size()));
+    }
+    return rx;
+}
+
+CRandomXHeader CRandomXHeader::FromBytes(const std::vector<unsigned char>& vchData)
+{
+    CRandomXHeader rx;
+    rx.nEncoding = RX_ENCODING_BINARY;
+    rx.vchHeader = vchData;
+    return rx;
+}
+
+std::string CRandomXHeader::ToString() const
+{
+    if (nEncoding == RX_ENCODING_BINARY)
+        return RX_HEADER_OPEN + HexStr(vchHeader) + RX_HEADER_CLOSE;
+    if (nEncoding == RX_ENCODING_LEGACY)
+        return strLegacy;
+    return std::string();
+}
+
 std::string CBlock::ToString() const
+{
+    return ToString(GetHash());
+}
+
+std::string CBlock::ToString(const uint256& hash) const
 {
     std::stringstream s;
     s << strprintf("CBlock(hash=%s, ver=0x%08x, hashPrevBlock=%s, hashMerkleRoot=%s, nTime=%u, nBits=%08x, nNonce=%u, vtx=%u)\n",
-        GetHash().ToString(),
+        hash.ToString(),
         nVersion,
         hashPrevBlock.ToString(),
         hashMerkleRoot.ToString(),
@@ -10,6 +10,68 @@
 #include "serialize.h"
 #include "uint256.h"
 
+/** RandomX proof carried by a block header.
+ * On the wire and in blk*.dat files the proof is the string
+ * "<rxheader>" + hex + "</rxheader>" (CBlockHeader::RandomXData). This class
+ * keeps the decoded bytes so proof-of-work checks never have to parse that
+ * string again, and serializes them in a compact, versioned binary form.
+ * Strings that are not in the canonical legacy form are kept verbatim so they
+ * can always be reproduced byte for byte.
+ */
+class CRandomXHeader
+{
+public:
+    enum Encoding : uint8_t {
+        RX_ENCODING_NONE = 0,   // no RandomX data (pre-RandomX headers)
+        RX_ENCODING_LEGACY = 1, // non-canonical string, stored as is
+        RX_ENCODING_BINARY = 2, // canonical string, stored as raw bytes
+    };
+
+private:
+    uint8_t nEncoding;
+    std::vector<unsigned char> vchHeader;
+    std::string strLegacy;
+
+public:
+    CRandomXHeader() : nEncoding(RX_ENCODING_NONE) {}
+
+    static CRandomXHeader FromString(const std::string& strData);
+    static CRandomXHeader FromBytes(const std::vector<unsigned char>& vchData);
+
+    /** The legacy "<rxheader>hex</rxheader>" string form */
+    std::string ToString() const;
+    /** The decoded RandomX block header that is fed to the RandomX hasher */
+    const std::vector<unsigned char>& GetBytes() const { return vchHeader; }
+
+    uint8_t GetEncoding() const { return nEncoding; }
+    bool IsNull() const { return nEncoding == RX_ENCODING_NONE; }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(nEncoding);
+        if (nEncoding == RX_ENCODING_BINARY) {
+            READWRITE(vchHeader);
+            strLegacy.clear();
+        } else if (nEncoding == RX_ENCODING_LEGACY) {
+            READWRITE(LIMITED_STRING(strLegacy, 2000));
+            if (ser_action.ForRead())
+                *this = FromString(strLegacy);
+        } else if (ser_action.ForRead()) {
+            if (nEncoding != RX_ENCODING_NONE)
+                throw std::ios_base::failure("CRandomXHeader: unknown encoding");
+            vchHeader.clear();
+            strLegacy.clear();
+        }
+    }
+
+    friend bool operator==(const CRandomXHeader& a, const CRandomXHeader& b)
+    {
+        return a.nEncoding == b.nEncoding && a.vchHeader == b.vchHeader && a.strLegacy == b.strLegacy;
+    }
+};
+
 
 /** Nodes collect new transactions into a block, hash them into a hash tree,
  * and scan through nonce values to make the block's hash satisfy proof-of-work
@@ -70,7 +132,15 @@ public:
         return (nBits == 0);
     }
 
+    static const size_t HASH_PREIMAGE_SIZE = 80;
+    /** The HASH_PREIMAGE_SIZE bytes that are hashed into the block hash */
+    void GetHashPreimage(unsigned char* preimage) const;
     uint256 GetHash() const;
+
+    CRandomXHeader GetRandomXHeader() const
+    {
+        return CRandomXHeader::FromString(RandomXData);
+    }
 	
 	//uint256 GetHashBible() const;
 
@@ -80,6 +150,9 @@ public:
     }
 };
 
+/** Hashes of a run of headers, e.g. a headers message, computed with HashX11Batch */
+std::vector<uint256> GetBlockHeaderHashes(const std::vector<CBlockHeader>& headers);
+
 
 class CBlock : public CBlockHeader
 {
@@ -131,6 +204,8 @@ public:
     }
 
     std::string ToString() const;
+    /** Same as ToString(), without rehashing for callers that already know the block hash */
+    std::string ToString(const uint256& hash) const;
 };
 
 
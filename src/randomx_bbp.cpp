@@ -6,87 +6,93 @@
 #include "randomx_bbp.h"
 #include "hash.h"
 
-static std::map<int, randomx_cache*> rxcache;
-static std::map<int, randomx_vm*> myvm;
-static std::map<int, bool> fInitialized;
-static std::map<int, bool> fBusy;
-static std::map<int, uint256> msGlobalKey;
+#include <map>
+#include <memory>
+#include <mutex>
 
-void init(uint256 uKey, int iThreadID)
+// One light mode cache (RANDOMX_ARGON_MEMORY KiB, 256 MB) per key, shared by the VMs of all thread IDs using it
+static std::mutex cs_rxcaches;
+static std::map<uint256, std::weak_ptr<randomx_cache> > mapRxCaches;
+
+// A VM per thread ID. Its mutex is only held by threads hashing with that ID, so distinct IDs hash in parallel
+struct CRandomXSlot
 {
-	std::vector<unsigned char> hashKey = std::vector<unsigned char>(uKey.begin(), uKey.end());
-	randomx_flags flags = randomx_get_flags();
-	rxcache[iThreadID] = randomx_alloc_cache(flags);
-	randomx_init_cache(rxcache[iThreadID], hashKey.data(), hashKey.size());
-	myvm[iThreadID] = randomx_create_vm(flags, rxcache[iThreadID], NULL);
-	fInitialized[iThreadID] = true;
-	msGlobalKey[iThreadID] = uKey;
+	std::mutex cs;
+	uint256 uKey;
+	std::shared_ptr<randomx_cache> cache;
+	randomx_vm* vm = nullptr;
+};
+static std::mutex cs_rxslots;
+static std::map<int, CRandomXSlot> mapRxSlots;
+
+static std::shared_ptr<randomx_cache> GetSharedCache(const uint256& uKey)
+{
+	// Initializing a cache takes a while; threads needing the same key wait for it rather than building another copy
+	std::unique_lock<std::mutex> lock(cs_rxcaches);
+	for (auto it = mapRxCaches.begin(); it != mapRxCaches.end(); ) {
+		if (it->second.expired())
+			it = mapRxCaches.erase(it);
+		else
+			++it;
+	}
+	std::shared_ptr<randomx_cache> cache = mapRxCaches[uKey].lock();
+	if (!cache) {
+		cache = std::shared_ptr<randomx_cache>(randomx_alloc_cache(randomx_get_flags()), randomx_release_cache);
+		randomx_init_cache(cache.get(), uKey.begin(), uKey.size());
+		mapRxCaches[uKey] = cache;
+	}
+	return cache;
 }
 
-void destroy(int iThreadID)
+static CRandomXSlot& GetSlot(int iThreadID)
 {
-	randomx_destroy_vm(myvm[iThreadID]);
-	randomx_release_cache(rxcache[iThreadID]);
-	fInitialized[iThreadID] = false;
-	fBusy[iThreadID] = false;
+	// std::map never moves its elements, so the slot stays valid after the lock is released
+	std::unique_lock<std::mutex> lock(cs_rxslots);
+	return mapRxSlots[iThreadID];
 }
 
-uint256 RandomX_Hash(uint256 hash, uint256 uKey, int iThreadID)
+static uint256 CalculateHash(int iThreadID, const uint256& uKey, const unsigned char* data, size_t nSize)
 {
-		if (fInitialized[iThreadID] && msGlobalKey[iThreadID] != uKey)
-		{
-			destroy(iThreadID);
-		}
+	CRandomXSlot& slot = GetSlot(iThreadID);
+	std::unique_lock<std::mutex> lock(slot.cs);
+	if (!slot.vm || slot.uKey != uKey) {
+		std::shared_ptr<randomx_cache> cache = GetSharedCache(uKey);
+		if (slot.vm)
+			randomx_vm_set_cache(slot.vm, cache.get());
+		else
+			slot.vm = randomx_create_vm(randomx_get_flags(), cache.get(), NULL);
+		// Releases the previous key's cache once no other slot uses it
+		slot.cache = cache;
+		slot.uKey = uKey;
+	}
+	uint256 hashOut;
+	randomx_calculate_hash(slot.vm, data, nSize, hashOut.begin());
+	return hashOut;
+}
 
-		if (!fInitialized[iThreadID] || uKey != msGlobalKey[iThreadID])
-		{
-			init(uKey, iThreadID);
-		}
-		std::vector<unsigned char> hashIn = std::vector<unsigned char>(hash.begin(), hash.end());
-		char *hashOut1 = (char*)malloc(RANDOMX_HASH_SIZE + 1);
-		fBusy[iThreadID] = true;
-		randomx_calculate_hash(myvm[iThreadID], hashIn.data(), hashIn.size(), hashOut1);
-		std::vector<unsigned char> data1(hashOut1, hashOut1 + RANDOMX_HASH_SIZE);
-		free(hashOut1);
-		fBusy[iThreadID] = false;
-		return uint256(data1);
+uint256 RandomX_Hash(uint256 hash, uint256 uKey, int iThreadID)
+{
+	return CalculateHash(iThreadID, uKey, hash.begin(), hash.size());
 }
 
 uint256 RandomX_Hash(std::vector<unsigned char> data0, uint256 uKey, int iThreadID)
 {
-		if (fInitialized[iThreadID] && msGlobalKey[iThreadID] != uKey)
-		{
-			destroy(iThreadID);
-		}
-
-		if (!fInitialized[iThreadID] || uKey != msGlobalKey[iThreadID])
-		{
-			init(uKey, iThreadID);
-		}
-		char *hashOut0 = (char*)malloc(RANDOMX_HASH_SIZE + 1);
-		fBusy[iThreadID] = true;
-		randomx_calculate_hash(myvm[iThreadID], data0.data(), data0.size(), hashOut0);
-		std::vector<unsigned char> data1(hashOut0, hashOut0 + RANDOMX_HASH_SIZE);
-		free(hashOut0);
-		fBusy[iThreadID] = false;
-		return uint256(data1);
+	return CalculateHash(iThreadID, uKey, data0.data(), data0.size());
 }
 
 
 uint256 RandomX_Hash(std::vector<unsigned char> data0, std::vector<unsigned char> datakey)
 {
-	int iThreadID = 101;
+	// One-off key, so a private cache and VM that are released right away
 	randomx_flags flags = randomx_get_flags();
-	rxcache[iThreadID] = randomx_alloc_cache(flags);
-	randomx_init_cache(rxcache[iThreadID], datakey.data(), datakey.size());
-	myvm[iThreadID] = randomx_create_vm(flags, rxcache[iThreadID], NULL);
-	char *hashOut0 = (char*)malloc(RANDOMX_HASH_SIZE + 1);
-	randomx_calculate_hash(myvm[iThreadID], data0.data(), data0.size(), hashOut0);
-	std::vector<unsigned char> data1(hashOut0, hashOut0 + RANDOMX_HASH_SIZE);
-	free(hashOut0);
-	randomx_destroy_vm(myvm[iThreadID]);
-	randomx_release_cache(rxcache[iThreadID]);
-	return uint256(data1);
+	randomx_cache* rxc = randomx_alloc_cache(flags);
+	randomx_init_cache(rxc, datakey.data(), datakey.size());
+	randomx_vm* vm = randomx_create_vm(flags, rxc, NULL);
+	uint256 hashOut;
+	randomx_calculate_hash(vm, data0.data(), data0.size(), hashOut.begin());
+	randomx_destroy_vm(vm);
+	randomx_release_cache(rxc);
+	return hashOut;
 }
 
 
@@ -114,10 +114,10 @@ UniValue blockheaderToJSON(const CBlockIndex* blockindex)
     result.push_back(Pair("difficulty", GetDifficulty(blockindex)));
     result.push_back(Pair("chainwork", blockindex->nChainWork.GetHex()));
 	result.push_back(Pair("randomx_key", blockindex->RandomXKey.GetHex()));
-	result.push_back(Pair("randomx_header", ExtractXML(blockindex->RandomXData, "<rxheader>", "</rxheader>")));
+	result.push_back(Pair("randomx_header", HexStr(blockindex->RandomXHeader.GetBytes())));
 	if (true)
 	{
-		uint256 uRX = GetRandomXHash(blockindex->RandomXData, blockindex->RandomXKey, blockindex->pprev->GetBlockHash(), 0);
+		uint256 uRX = GetRandomXHash(blockindex->RandomXHeader.GetBytes(), blockindex->RandomXKey, blockindex->pprev->GetBlockHash(), 0);
 		result.push_back(Pair("RandomX_Hash", uRX.GetHex()));
 	}
     if (blockindex->pprev)
@@ -185,7 +185,7 @@ UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool tx
 	{
         result.push_back(Pair("previousblockhash", blockindex->pprev->GetBlockHash().GetHex()));
 		const Consensus::Params& consensusParams = Params().GetConsensus();
-		std::string sVerses = GetBibleHashVerses(block.GetHash(), block.GetBlockTime(), blockindex->pprev->nTime, blockindex->pprev->nHeight, blockindex->pprev);
+		std::string sVerses = GetBibleHashVerses(blockindex->GetBlockHash(), block.GetBlockTime(), blockindex->pprev->nTime, blockindex->pprev->nHeight, blockindex->pprev);
 		if (bShowPrayers) 
 			result.push_back(Pair("verses", sVerses));
 		result.push_back(Pair("chaindata", block.vtx[0]->vout[0].sTxOutMessage));
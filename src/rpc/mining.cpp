@@ -229,12 +229,17 @@ UniValue getmininginfo(const JSONRPCRequest& request)
             "  \"networkhashps\": nnn,      (numeric) The network hashes per second\n"
             "  \"pooledtx\": n              (numeric) The size of the mempool\n"
             "  \"chain\": \"xxxx\",         (string) current network name as defined in BIP70 (main, test, regtest)\n"
+            "  \"threadhashps\": [ n, ... ]  (array) The hashes per second of each internal miner thread\n"
             "}\n"
 		    "\nExamples:\n"
             + HelpExampleCli("getmininginfo", "")
             + HelpExampleRpc("getmininginfo", "")
         );
 
+	// Before cs_main: the miner threads take cs_main while holding the coordinator lock
+	UniValue threadHashes(UniValue::VARR);
+	for (double dThreadHashesPerSec : miningCoordinator.GetThreadHashesPerSec())
+		threadHashes.push_back(dThreadHashesPerSec);
 
     LOCK(cs_main);
 	UniValue obj(UniValue::VOBJ);
@@ -250,6 +255,7 @@ UniValue getmininginfo(const JSONRPCRequest& request)
 	obj.push_back(Pair("hashps",           dHashesPerSec));
 	obj.push_back(Pair("minerstarttime",   TimestampToHRDate(nHPSTimerStart/1000)));
 	obj.push_back(Pair("hashcounter",      nHashCounter));
+	obj.push_back(Pair("threadhashps",     threadHashes));
 	obj.push_back(Pair("pooledtx",         (uint64_t)mempool.size()));
 	obj.push_back(Pair("chain",            Params().NetworkIDString()));
 	obj.push_back(Pair("dac-generate",getgenerate(request)));
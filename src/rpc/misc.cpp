@@ -6,11 +6,13 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "base58.h"
+#include "blockcache.h"
 #include "clientversion.h"
 #include "init.h"
 #include "net.h"
 #include "netbase.h"
 #include "rpc/server.h"
+#include "rpcpog.h"
 #include "timedata.h"
 #include "txmempool.h"
 #include "util.h"
@@ -1121,6 +1123,42 @@ static UniValue RPCLockedMemoryInfo()
     return obj;
 }
 
+static UniValue RPCBlockCacheInfo()
+{
+    CRecentBlockCache::Stats stats = recentBlockCache.GetStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("entries", uint64_t(stats.nEntries)));
+    obj.push_back(Pair("bytes", uint64_t(stats.nBytes)));
+    obj.push_back(Pair("maxbytes", uint64_t(stats.nMaxBytes)));
+    obj.push_back(Pair("hits", stats.nHits));
+    obj.push_back(Pair("misses", stats.nMisses));
+    return obj;
+}
+
+static UniValue RPCApplicationCacheInfo()
+{
+    size_t nMaxBytes, nEvictableBytes;
+    std::map<std::string, ApplicationCacheSectionStats> mapSections = GetApplicationCacheStats(nMaxBytes, nEvictableBytes);
+    uint64_t nEntries = 0, nBytes = 0;
+    UniValue sections(UniValue::VOBJ);
+    for (const auto& pair : mapSections) {
+        UniValue section(UniValue::VOBJ);
+        section.push_back(Pair("entries", uint64_t(pair.second.nEntries)));
+        section.push_back(Pair("bytes", uint64_t(pair.second.nBytes)));
+        section.push_back(Pair("evictable", pair.second.fEvictable));
+        sections.push_back(Pair(pair.first, section));
+        nEntries += pair.second.nEntries;
+        nBytes += pair.second.nBytes;
+    }
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("entries", nEntries));
+    obj.push_back(Pair("bytes", nBytes));
+    obj.push_back(Pair("evictablebytes", uint64_t(nEvictableBytes)));
+    obj.push_back(Pair("maxbytes", uint64_t(nMaxBytes)));
+    obj.push_back(Pair("sections", sections));
+    return obj;
+}
+
 UniValue getmemoryinfo(const JSONRPCRequest& request)
 {
     /* Please, avoid using the word "pool" here in the RPC interface or help,
@@ -1139,6 +1177,22 @@ UniValue getmemoryinfo(const JSONRPCRequest& request)
             "    \"locked\": xxxxxx,       (numeric) Amount of bytes that succeeded locking. If this number is smaller than total, locking pages failed at some point and key data could be swapped to disk.\n"
             "    \"chunks_used\": xxxxx,   (numeric) Number allocated chunks\n"
             "    \"chunks_free\": xxxxx,   (numeric) Number unused chunks\n"
+            "  },\n"
+            "  \"blockcache\": {           (json object) Information about the recently used block cache\n"
+            "    \"entries\": xxxxx,       (numeric) Number of cached blocks\n"
+            "    \"bytes\": xxxxx,         (numeric) Serialized size of the cached blocks\n"
+            "    \"maxbytes\": xxxxx,      (numeric) Configured limit (-maxblockcache)\n"
+            "    \"hits\": xxxxx,          (numeric) Number of block reads served from the cache\n"
+            "    \"misses\": xxxxx,        (numeric) Number of block reads that went to disk\n"
+            "  },\n"
+            "  \"appcache\": {             (json object) Information about the application cache (prayers, sporks, CPKs...)\n"
+            "    \"entries\": xxxxx,       (numeric) Number of entries\n"
+            "    \"bytes\": xxxxx,         (numeric) Estimated memory usage of the entries\n"
+            "    \"evictablebytes\": xxxxx, (numeric) Estimated memory usage of the non-consensus sections\n"
+            "    \"maxbytes\": xxxxx,      (numeric) Configured limit for the non-consensus sections (-maxappcache)\n"
+            "    \"sections\": {           (json object) The same figures per section, with \"evictable\" marking non-consensus sections\n"
+            "      ...\n"
+            "    }\n"
             "  }\n"
             "}\n"
             "\nExamples:\n"
@@ -1147,6 +1201,8 @@ UniValue getmemoryinfo(const JSONRPCRequest& request)
         );
     UniValue obj(UniValue::VOBJ);
     obj.push_back(Pair("locked", RPCLockedMemoryInfo()));
+    obj.push_back(Pair("blockcache", RPCBlockCacheInfo()));
+    obj.push_back(Pair("appcache", RPCApplicationCacheInfo()));
     return obj;
 }
 
@@ -262,16 +262,19 @@ std::map<std::string, Researcher> GetPayableResearchers()
 	vFIFO.reserve(mvResearchers.size() * 2);
 	std::map<std::string, Researcher> r;
 	std::map<std::string, std::string> cpid_reverse_lookup;
-	for (auto ii : mvApplicationCache)
 	{
-		if (Contains(ii.first.first, "CPK-WCG"))
+		LOCK(csApplicationCache);
+		for (auto ii : mvApplicationCache)
 		{
-			std::string sData = ii.second.first;
-			int64_t nLockTime = ii.second.second;
-			std::string cpid = GetCPIDElementByData(sData, 8);
-			std::string sCPK = GetCPIDElementByData(sData, 0);
-			vFIFO.push_back(std::make_tuple(nLockTime, cpid, sCPK));
-			LogPrintf("cpid %s cpk %s locktime %f", cpid, sCPK, nLockTime);
+			if (Contains(ii.first.first, "CPK-WCG"))
+			{
+				std::string sData = ii.second.first;
+				int64_t nLockTime = ii.second.second;
+				std::string cpid = GetCPIDElementByData(sData, 8);
+				std::string sCPK = GetCPIDElementByData(sData, 0);
+				vFIFO.push_back(std::make_tuple(nLockTime, cpid, sCPK));
+				LogPrintf("cpid %s cpk %s locktime %f", cpid, sCPK, nLockTime);
+			}
 		}
 	}
 		
@@ -14,6 +14,8 @@
 #include "governance.h"
 #include "masternode-sync.h"
 #include "masternode-payments.h"
+#include "memusage.h"
+#include "messagesigcache.h"
 #include "messagesigner.h"
 #include "smartcontract-server.h"
 #include "smartcontract-client.h"
@@ -43,6 +45,8 @@
 #include "wallet/wallet.h"
 #include <sstream>
 #include "randomx_bbp.h"
+#include "saltedhasher.h"
+#include "unordered_lru_cache.h"
 
 #ifdef ENABLE_WALLET
 extern CWallet* pwalletMain;
@@ -187,16 +191,12 @@ std::string GetElement(std::string sIn, std::string sDelimiter, int iPos)
 
 std::string GetSporkValue(std::string sKey)
 {
-	boost::to_upper(sKey);
-    std::pair<std::string, int64_t> v = mvApplicationCache[std::make_pair("SPORK", sKey)];
-	return v.first;
+	return sporkManager.GetSnapshot()->GetString(sKey);
 }
 
 double GetSporkDouble(std::string sName, double nDefault)
 {
-	double dSetting = cdbl(GetSporkValue(sName), 2);
-	if (dSetting == 0) return nDefault;
-	return dSetting;
+	return sporkManager.GetSnapshot()->GetDouble(sName, nDefault);
 }
 
 std::map<std::string, std::string> GetSporkMap(std::string sPrimaryKey, std::string sSecondaryKey)
@@ -204,8 +204,8 @@ std::map<std::string, std::string> GetSporkMap(std::string sPrimaryKey, std::str
 	boost::to_upper(sPrimaryKey);
 	boost::to_upper(sSecondaryKey);
 	std::string sDelimiter = "|";
-    std::pair<std::string, int64_t> v = mvApplicationCache[std::make_pair(sPrimaryKey, sSecondaryKey)];
-	std::vector<std::string> vSporks = Split(v.first, sDelimiter);
+	std::string sValue = (sPrimaryKey == "SPORK") ? GetSporkValue(sSecondaryKey) : ReadCache(sPrimaryKey, sSecondaryKey);
+	std::vector<std::string> vSporks = Split(sValue, sDelimiter);
 	std::map<std::string, std::string> mSporkMap;
 	for (int i = 0; i < vSporks.size(); i++)
 	{
@@ -249,12 +249,17 @@ bool CheckStakeSignature(std::string sBitcoinAddress, std::string sSignature, st
 	CHashWriter ss2(SER_GETHASH, 0);
 	ss2 << strMessageMagic;
 	ss2 << strMessage;
+	uint256 hashMessage = ss2.GetHash();
+	if (GetCachedMessageSignature(keyID2, hashMessage, vchSig2))
+		return true;
 	CPubKey pubkey2;
-    if (!pubkey2.RecoverCompact(ss2.GetHash(), vchSig2)) 
+    if (!pubkey2.RecoverCompact(hashMessage, vchSig2)) 
 	{
 		strError = "Unable to recover public key.";
 		return false;
 	}
+	// The signature is valid for the recovered key whether or not that is the one asked for
+	AddCachedMessageSignature(pubkey2.GetID(), hashMessage, vchSig2);
 	bool fSuccess = (pubkey2.GetID() == keyID2);
 	return fSuccess;
 }
@@ -297,6 +302,7 @@ std::map<std::string, CPK> GetChildMap(std::string sGSCObjType)
 	std::map<std::string, CPK> mCPKMap;
 	boost::to_upper(sGSCObjType);
 	int i = 0;
+	LOCK(csApplicationCache);
 	for (auto ii : mvApplicationCache)
 	{
 		if (Contains(ii.first.first, sGSCObjType))
@@ -314,6 +320,7 @@ std::map<std::string, CPK> GetGSCMap(std::string sGSCObjType, std::string sSearc
 {
 	std::map<std::string, CPK> mCPKMap;
 	boost::to_upper(sGSCObjType);
+	LOCK(csApplicationCache);
 	for (auto ii : mvApplicationCache)
 	{
     	if (ii.first.first == sGSCObjType)
@@ -340,10 +347,8 @@ CAmount CAmountFromValue(const UniValue& value)
     return amount;
 }
 
-static CCriticalSection csReadWait;
 std::string ReadCache(std::string sSection, std::string sKey)
 {
-	LOCK(csReadWait);
 	std::string sLookupSection = sSection;
 	std::string sLookupKey = sKey;
 	boost::to_upper(sLookupSection);
@@ -351,8 +356,9 @@ std::string ReadCache(std::string sSection, std::string sKey)
 	// NON-CRITICAL TODO : Find a way to eliminate this to_upper while we transition to non-financial transactions
 	if (sLookupSection.empty() || sLookupKey.empty())
 		return std::string();
-	std::pair<std::string, int64_t> t = mvApplicationCache[std::make_pair(sLookupSection, sLookupKey)];
-	return t.first;
+	LOCK(csApplicationCache);
+	auto it = mvApplicationCache.find(std::make_pair(sLookupSection, sLookupKey));
+	return it == mvApplicationCache.end() ? std::string() : it->second.first;
 }
 
 std::string TimestampToHRDate(double dtm)
@@ -1045,34 +1051,173 @@ bool CheckNonce(bool f9000, unsigned int nNonce, int nPrevHeight, int64_t nPrevB
 	return (nNonce > nMaxNonce) ? false : true;
 }
 
-static CCriticalSection csClearWait;
-void ClearCache(std::string sSection)
+// Application cache accounting. Sections that consensus code reads (sporks, CPKs, DWS burns, CPID
+// lookups...) are kept for the life of the node; the sections below only feed the UI and RPCs, so
+// their entries expire after nAppCacheMaxAge seconds and the oldest are evicted above nAppCacheMaxBytes
+// (0 disables either limit).
+static const char* const vEvictableCacheSections[] = {
+	"PRAYER", "MESSAGE", "REPENT", "ATTACHMENT", "DIARY",
+	"VIN", "COIN", "AVAILABLECOINS", "ANALYSIS", "GSC", "POOLCACHE", "POOLTHREAD", "CHILD_DATA",
+};
+static size_t nAppCacheMaxBytes = DEFAULT_MAX_APPLICATION_CACHE << 20;
+static int64_t nAppCacheMaxAge = DEFAULT_APPLICATION_CACHE_TTL * 86400;
+static size_t nAppCacheEvictableBytes = 0;
+static std::map<std::string, ApplicationCacheSectionStats> mapAppCacheSections;
+
+bool IsEvictableCacheSection(const std::string& sSection)
 {
-	LOCK(csClearWait);
-	boost::to_upper(sSection);
-	for (auto ii : mvApplicationCache) 
+	for (const char* pszSection : vEvictableCacheSections)
+	{
+		// POOLTHREAD<n> and CHILD_DATA_TIMESTAMP_<charity> are numbered by suffix
+		if (sSection.compare(0, strlen(pszSection), pszSection) == 0)
+			return true;
+	}
+	return false;
+}
+
+static size_t CacheStringUsage(const std::string& s)
+{
+	// Short strings live inside the std::string itself
+	return s.capacity() > 15 ? memusage::MallocUsage(s.capacity() + 1) : 0;
+}
+
+static size_t CacheEntryUsage(const std::pair<std::string, std::string>& key, const std::pair<std::string, int64_t>& value)
+{
+	return memusage::IncrementalDynamicUsage(mvApplicationCache) + CacheStringUsage(key.first) + CacheStringUsage(key.second) + CacheStringUsage(value.first);
+}
+
+static void AccountCacheEntry(const std::pair<std::string, std::string>& key, const std::pair<std::string, int64_t>& value, bool fAdd)
+{
+	AssertLockHeld(csApplicationCache);
+	ApplicationCacheSectionStats& stats = mapAppCacheSections[key.first];
+	size_t nUsage = CacheEntryUsage(key, value);
+	if (fAdd) {
+		stats.nEntries++;
+		stats.nBytes += nUsage;
+		if (stats.fEvictable) nAppCacheEvictableBytes += nUsage;
+	} else {
+		stats.nEntries--;
+		stats.nBytes -= nUsage;
+		if (stats.fEvictable) nAppCacheEvictableBytes -= nUsage;
+		if (stats.nEntries == 0) mapAppCacheSections.erase(key.first);
+	}
+}
+
+static void EraseCacheEntry(std::map<std::pair<std::string, std::string>, std::pair<std::string, int64_t>>::iterator it)
+{
+	AccountCacheEntry(it->first, it->second, false);
+	mvApplicationCache.erase(it);
+}
+
+static void TrimApplicationCache()
+{
+	AssertLockHeld(csApplicationCache);
+	if (nAppCacheMaxBytes == 0 || nAppCacheEvictableBytes <= nAppCacheMaxBytes) return;
+	// Evict the oldest entries down to 90% of the limit, so a full cache is not re-sorted on every write
+	std::vector<std::pair<int64_t, std::map<std::pair<std::string, std::string>, std::pair<std::string, int64_t>>::iterator>> vEvictable;
+	for (auto it = mvApplicationCache.begin(); it != mvApplicationCache.end(); ++it)
+	{
+		if (IsEvictableCacheSection(it->first.first))
+			vEvictable.emplace_back(it->second.second, it);
+	}
+	std::sort(vEvictable.begin(), vEvictable.end(), [](const decltype(vEvictable)::value_type& a, const decltype(vEvictable)::value_type& b) { return a.first < b.first; });
+	size_t nTarget = nAppCacheMaxBytes / 10 * 9;
+	int nEvicted = 0;
+	for (const auto& item : vEvictable)
+	{
+		if (nAppCacheEvictableBytes <= nTarget) break;
+		EraseCacheEntry(item.second);
+		nEvicted++;
+	}
+	LogPrintf("TrimApplicationCache: evicted %d entries, %u bytes left in evictable sections\n", nEvicted, nAppCacheEvictableBytes);
+}
+
+void SetApplicationCacheLimits(size_t nMaxBytes, int64_t nMaxAge)
+{
+	LOCK(csApplicationCache);
+	nAppCacheMaxBytes = nMaxBytes;
+	nAppCacheMaxAge = nMaxAge;
+	TrimApplicationCache();
+}
+
+void ExpireApplicationCache()
+{
+	LOCK(csApplicationCache);
+	if (nAppCacheMaxAge == 0) return;
+	int64_t nCutoff = GetAdjustedTime() - nAppCacheMaxAge;
+	int nExpired = 0;
+	for (auto it = mvApplicationCache.begin(); it != mvApplicationCache.end(); )
 	{
-		if (ii.first.first == sSection)
+		// Timestamp 0 with an empty value is a cleared entry from an older prayers file
+		bool fExpired = it->second.second == 0 ? it->second.first.empty() : it->second.second < nCutoff;
+		if (fExpired && IsEvictableCacheSection(it->first.first))
 		{
-			mvApplicationCache[std::make_pair(ii.first.first, ii.first.second)] = std::make_pair(std::string(), 0);
+			EraseCacheEntry(it++);
+			nExpired++;
 		}
+		else
+		{
+			++it;
+		}
+	}
+	if (nExpired > 0)
+		LogPrintf("ExpireApplicationCache: expired %d entries\n", nExpired);
+}
+
+std::map<std::string, ApplicationCacheSectionStats> GetApplicationCacheStats(size_t& nMaxBytesRet, size_t& nEvictableBytesRet)
+{
+	LOCK(csApplicationCache);
+	nMaxBytesRet = nAppCacheMaxBytes;
+	nEvictableBytesRet = nAppCacheEvictableBytes;
+	return mapAppCacheSections;
+}
+
+void ClearCache(std::string sSection)
+{
+	boost::to_upper(sSection);
+	LOCK(csApplicationCache);
+	if (sSection == "SPORK")
+		sporkManager.ClearStringSporks();
+	// Entries are ordered by section, so the whole section is one contiguous range
+	auto it = mvApplicationCache.lower_bound(std::make_pair(sSection, std::string()));
+	while (it != mvApplicationCache.end() && it->first.first == sSection)
+	{
+		EraseCacheEntry(it++);
 	}
 }
 
-static CCriticalSection csWriteWait;
 void WriteCache(std::string sSection, std::string sKey, std::string sValue, int64_t locktime, bool IgnoreCase)
 {
-	LOCK(csWriteWait);
 	if (sSection.empty() || sKey.empty()) return;
 	if (IgnoreCase)
 	{
 		boost::to_upper(sSection);
 		boost::to_upper(sKey);
 	}
+	LOCK(csApplicationCache);
+	bool fEvictable = IsEvictableCacheSection(sSection);
+	// Don't bring back entries that would expire right away (old prayers file, rescans)
+	if (fEvictable && nAppCacheMaxAge > 0 && locktime > 0 && locktime < GetAdjustedTime() - nAppCacheMaxAge)
+		return;
 	std::pair<std::string, std::string> s1 = std::make_pair(sSection, sKey);
 	// Record Cache Entry timestamp
 	std::pair<std::string, int64_t> v1 = std::make_pair(sValue, locktime);
-	mvApplicationCache[s1] = v1;
+	auto it = mvApplicationCache.find(s1);
+	if (it != mvApplicationCache.end())
+	{
+		AccountCacheEntry(it->first, it->second, false);
+		it->second = v1;
+	}
+	else
+	{
+		it = mvApplicationCache.emplace(s1, v1).first;
+	}
+	mapAppCacheSections[sSection].fEvictable = fEvictable;
+	AccountCacheEntry(it->first, it->second, true);
+	if (fEvictable)
+		TrimApplicationCache();
+	if (sSection == "SPORK")
+		sporkManager.SetStringSpork(sKey, sValue, cdbl(sValue, 2));
 }
 
 void WriteCacheDouble(std::string sKey, double dValue)
@@ -1262,6 +1407,7 @@ UniValue GetDataList(std::string sType, int iMaxAgeInDays, int& iSpecificEntry,
 	ret.push_back(Pair("DataList",sType));
 	int iPos = 0;
 	int iTotalRecords = 0;
+	LOCK(csApplicationCache);
 	for (auto ii : mvApplicationCache) 
 	{
 		if (ii.first.first == sType)
@@ -1360,13 +1506,14 @@ void SerializePrayersToFile(int nHeight)
 	std::string sTarget = GetSANDirectory2() + "prayers2" + sSuffix;
 	FILE *outFile = fopen(sTarget.c_str(), "w");
 	LogPrintf("Serializing Prayers... %f ", GetAdjustedTime());
+	LOCK(csApplicationCache);
 	for (auto ii : mvApplicationCache) 
 	{
 		std::pair<std::string, int64_t> v = mvApplicationCache[std::make_pair(ii.first.first, ii.first.second)];
 	   	int64_t nTimestamp = v.second;
 		std::string sValue = v.first;
 		bool bSkip = false;
-		if (ii.first.first == "MESSAGE" && (sValue == std::string() || sValue == std::string()))
+		if (sValue.empty())
 			bSkip = true;
 		if (!bSkip)
 		{
@@ -2413,45 +2560,73 @@ void ProcessBLSCommand(CTransactionRef tx)
 	}
 }
 
-bool CheckAntiBotNetSignature(CTransactionRef tx, std::string sType, std::string sSolver)
+bool CheckTxMessageSignature(CTransactionRef tx, std::string sType)
 {
+	// Only touches the transaction, so this is safe to run on the signature check threads
 	std::string sXML = GetTransactionMessage(tx);
 	std::string sSig = ExtractXML(sXML, "<" + sType + "sig>", "</" + sType + "sig>");
 	std::string sMessage = ExtractXML(sXML, "<abnmsg>", "</abnmsg>");
-	std::string sPPK = ExtractXML(sMessage, "<ppk>", "</ppk>");
-	double dCheckPoolSigs = GetSporkDouble("checkpoolsigs", 0);
+	bool fInvalid = false;
+	std::vector<unsigned char> vchSig = DecodeBase64(sSig.c_str(), &fInvalid);
+	if (fInvalid)
+		return false;
+	CHashWriter ss(SER_GETHASH, 0);
+	ss << strMessageMagic;
+	ss << sMessage;
+	uint256 hashMessage = ss.GetHash();
+
+	// The signer must own one of the outputs; collect their key ids and recover the signer once
+	std::vector<CKeyID> vKeyIDs;
+	for (unsigned int i = 0; i < tx->vout.size(); i++)
+	{
+		CTxDestination dest;
+		if (!ExtractDestination(tx->vout[i].scriptPubKey, dest))
+			continue;
+		const CKeyID* pKeyID = boost::get<CKeyID>(&dest);
+		if (!pKeyID)
+			continue;
+		if (GetCachedMessageSignature(*pKeyID, hashMessage, vchSig))
+			return true;
+		vKeyIDs.push_back(*pKeyID);
+	}
+	if (vKeyIDs.empty())
+		return false;
+	CPubKey pubkey;
+	if (!pubkey.RecoverCompact(hashMessage, vchSig))
+		return false;
+	CKeyID keyID = pubkey.GetID();
+	AddCachedMessageSignature(keyID, hashMessage, vchSig);
+	return std::find(vKeyIDs.begin(), vKeyIDs.end(), keyID) != vKeyIDs.end();
+}
 
-	if (!sSolver.empty() && !sPPK.empty() && dCheckPoolSigs == 1)
+bool CheckAntiBotNetSignature(CTransactionRef tx, std::string sType, std::string sSolver)
+{
+	if (!sSolver.empty())
 	{
-		if (sSolver != sPPK)
+		std::string sXML = GetTransactionMessage(tx);
+		std::string sMessage = ExtractXML(sXML, "<abnmsg>", "</abnmsg>");
+		std::string sPPK = ExtractXML(sMessage, "<ppk>", "</ppk>");
+		double dCheckPoolSigs = GetSporkDouble("checkpoolsigs", 0);
+		if (!sPPK.empty() && dCheckPoolSigs == 1 && sSolver != sPPK)
 		{
 			LogPrintf("CheckAntiBotNetSignature::Pool public key != solver public key, signature %s \n", "rejected");
 			return false;
 		}
 	}
-	for (unsigned int i = 0; i < tx->vout.size(); i++)
-	{
-		const CTxOut& txout = tx->vout[i];
-		std::string sAddr = PubKeyToAddress(txout.scriptPubKey);
-		std::string sError;
-		bool fSigned = CheckStakeSignature(sAddr, sSig, sMessage, sError);
-		if (fSigned)
-			return true;
-	}
-	return false;
+	return CheckTxMessageSignature(tx, sType);
 }
 
 double GetVINCoinAge(int64_t nBlockTime, CTransactionRef tx, bool fDebug)
 {
 	double dTotal = 0;
 	std::string sDebugData = "\nGetVINCoinAge: ";
+	double nSancScalpingDisabled = GetSporkDouble("preventsanctuaryscalping", 0);
 	for (int i = 0; i < (int)tx->vin.size(); i++) 
 	{
     	int n = tx->vin[i].prevout.n;
 		CAmount nAmount = 0;
 		int64_t nTime = 0;
 		bool fOK = GetTransactionTimeAndAmount(tx->vin[i].prevout.hash, n, nTime, nAmount);
-		double nSancScalpingDisabled = GetSporkDouble("preventsanctuaryscalping", 0);
 		if (nSancScalpingDisabled == 1 && nAmount == (SANCTUARY_COLLATERAL * COIN)) 
 		{
 			LogPrintf("\nGetVinCoinAge, Detected unlocked sanctuary in txid %s, Amount %f ", tx->GetHash().GetHex(), nAmount/COIN);
@@ -2797,9 +2972,9 @@ double GetFees(CTransactionRef tx)
 
 int64_t GetCacheEntryAge(std::string sSection, std::string sKey)
 {
-	LOCK(csReadWait);
-	std::pair<std::string, int64_t> v = mvApplicationCache[std::make_pair(sSection, sKey)];
-	int64_t nTimestamp = v.second;
+	LOCK(csApplicationCache);
+	auto it = mvApplicationCache.find(std::make_pair(sSection, sKey));
+	int64_t nTimestamp = it == mvApplicationCache.end() ? 0 : it->second.second;
 	int64_t nAge = GetAdjustedTime() - nTimestamp;
 	return nAge;
 }
@@ -3231,6 +3406,7 @@ std::string GetResElement(std::string data, int iElement)
 
 std::string GetResDataBySearch(std::string sSearch)
 {
+	LOCK(csApplicationCache);
 	for (auto ii : mvApplicationCache) 
 	{
 		if (ii.first.first == "CPK-WCG")
@@ -3411,26 +3587,28 @@ WhaleStake GetWhaleStake(CTransactionRef tx1)
 std::vector<WhaleStake> GetDWS(bool fIncludeMemoryPool)
 {
 	std::vector<WhaleStake> wStakes;
-	for (auto ii : mvApplicationCache) 
+	// GetTxDAC may lock cs_main, which is taken before csApplicationCache elsewhere, so copy the burns out first
+	std::vector<std::string> vBurnTxIds;
 	{
-		if (ii.first.first == "DWS-BURN")
+		LOCK(csApplicationCache);
+		auto it = mvApplicationCache.lower_bound(std::make_pair(std::string("DWS-BURN"), std::string()));
+		for (; it != mvApplicationCache.end() && it->first.first == "DWS-BURN"; ++it)
+			vBurnTxIds.push_back(it->first.second);
+	}
+	for (const std::string& sTXID : vBurnTxIds)
+	{
+		uint256 hashInput = uint256S(sTXID);
+		CTransactionRef tx1;
+		bool fGot = GetTxDAC(hashInput, tx1);
+		if (fGot)
 		{
-			std::pair<std::string, int64_t> v = mvApplicationCache[std::make_pair(ii.first.first, ii.first.second)];
-			int64_t nTimestamp = v.second;
-			std::string sTXID = ii.first.second;
-			uint256 hashInput = uint256S(sTXID);
-			CTransactionRef tx1;
-			bool fGot = GetTxDAC(hashInput, tx1);
-			if (fGot)
+			WhaleStake w = GetWhaleStake(tx1);
+			if (w.found && w.RewardAmount > 0 && w.Amount > 0 && w.ActualDWU > 0)
 			{
-				WhaleStake w = GetWhaleStake(tx1);
-				if (w.found && w.RewardAmount > 0 && w.Amount > 0 && w.ActualDWU > 0)
-				{
-					wStakes.push_back(w);
-					if (fDebugSpam)
-						LogPrintf("\nDWS BurnTime %f, MaturityTime %f, TxID %s, Msg %s, Amount %f, Duration %f, DWU %f \n", 
-							w.BurnTime, w.MaturityTime, w.TXID.GetHex(), w.XML, (double)w.Amount, w.Duration, w.DWU);
-				}
+				wStakes.push_back(w);
+				if (fDebugSpam)
+					LogPrintf("\nDWS BurnTime %f, MaturityTime %f, TxID %s, Msg %s, Amount %f, Duration %f, DWU %f \n", 
+						w.BurnTime, w.MaturityTime, w.TXID.GetHex(), w.XML, (double)w.Amount, w.Duration, w.DWU);
 			}
 		}
 	}
@@ -3930,20 +4108,42 @@ std::string ReverseHex(std::string const & src)
     return result;
 }
 
-static std::map<int, std::mutex> cs_rxhash;
+static std::mutex cs_rxhashcache;
+static unordered_lru_cache<uint256, uint256, StaticSaltedHasher> mapRandomXHashCache(RANDOMX_HASH_CACHE_SIZE);
+
 uint256 GetRandomXHash(std::string sHeaderHex, uint256 key, uint256 hashPrevBlock, int iThreadID)
+{
+	return GetRandomXHash(CRandomXHeader::FromString(sHeaderHex).GetBytes(), key, hashPrevBlock, iThreadID);
+}
+
+uint256 GetRandomXHash(const std::vector<unsigned char>& vchHeader, uint256 key, uint256 hashPrevBlock, int iThreadID)
 {
 	// *****************************************                      RandomX                                    ************************************************************************
 	// Starting at RANDOMX_HEIGHT, we now solve for an equation, rather than simply the difficulty and target.  (See prevention of preimage attacks in our wiki https://wiki.biblepay.org/Preventing_Preimage_Attacks)
 	// This is so our miners may earn a dual revenue stream (RandomX coins + DAC/BiblePay Coins).
 	// The equation is:  BlakeHash(Previous_DAC_Hash + RandomX_Hash(RandomX_Coin_Header)) < Current_DAC_Block_Difficulty
 	// **********************************************************************************************************************************************************************************
-	std::unique_lock<std::mutex> lock(cs_rxhash[iThreadID]);
 	std::vector<unsigned char> vch(160);
 	CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION, vch, 0);
-	std::string randomXBlockHeader = ExtractXML(sHeaderHex, "<rxheader>", "</rxheader>");
-	std::vector<unsigned char> data0 = ParseHex(randomXBlockHeader);
-	uint256 uRXMined = RandomX_Hash(data0, key, iThreadID);
+	uint256 uRXMined = RandomX_Hash(vchHeader, key, iThreadID);
 	ss << hashPrevBlock << uRXMined;
 	return HashBlake((const char *)vch.data(), (const char *)vch.data() + vch.size());
 }
+
+uint256 GetCachedRandomXHash(const std::vector<unsigned char>& vchHeader, uint256 key, uint256 hashPrevBlock, int iThreadID)
+{
+	// Block headers are proof-of-work checked more than once (header sync, AcceptBlock, ConnectBlock, reindex), so remember recent results
+	CHashWriter hw(SER_GETHASH, 0);
+	hw << vchHeader << key << hashPrevBlock;
+	uint256 uCacheKey = hw.GetHash();
+	uint256 uRX;
+	{
+		std::unique_lock<std::mutex> lock(cs_rxhashcache);
+		if (mapRandomXHashCache.get(uCacheKey, uRX))
+			return uRX;
+	}
+	uRX = GetRandomXHash(vchHeader, key, hashPrevBlock, iThreadID);
+	std::unique_lock<std::mutex> lock(cs_rxhashcache);
+	mapRandomXHashCache.insert(uCacheKey, uRX);
+	return uRX;
+}
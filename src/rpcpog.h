@@ -14,9 +14,22 @@
 
 class CWallet;
 
+/** Number of recent RandomX proof-of-work results remembered by GetCachedRandomXHash */
+static const unsigned int RANDOMX_HASH_CACHE_SIZE = 10000;
+/** Default for -maxappcache, in megabytes: memory limit for the non-consensus application cache sections */
+static const unsigned int DEFAULT_MAX_APPLICATION_CACHE = 64;
+/** Default for -appcachettl, in days: age at which non-consensus application cache entries expire */
+static const unsigned int DEFAULT_APPLICATION_CACHE_TTL = 90;
 
 std::string RetrieveMd5(std::string s1);
 
+struct ApplicationCacheSectionStats
+{
+	size_t nEntries = 0;
+	size_t nBytes = 0;
+	bool fEvictable = false;
+};
+
 struct UserVote
 {
 	int nTotalYesCount = 0;
@@ -193,6 +206,10 @@ std::string AddBlockchainMessages(std::string sAddress, std::string sType, std::
 std::string ReadCache(std::string sSection, std::string sKey);
 void ClearCache(std::string sSection);
 void WriteCache(std::string sSection, std::string sKey, std::string sValue, int64_t locktime, bool IgnoreCase=true);
+bool IsEvictableCacheSection(const std::string& sSection);
+void SetApplicationCacheLimits(size_t nMaxBytes, int64_t nMaxAge);
+void ExpireApplicationCache();
+std::map<std::string, ApplicationCacheSectionStats> GetApplicationCacheStats(size_t& nMaxBytesRet, size_t& nEvictableBytesRet);
 std::string GetSporkValue(std::string sKey);
 std::string TimestampToHRDate(double dtm);
 std::string GetArrayElement(std::string s, std::string delim, int iPos);
@@ -251,6 +268,7 @@ std::map<std::string, std::string> GetSporkMap(std::string sPrimaryKey, std::str
 std::map<std::string, CPK> GetGSCMap(std::string sGSCObjType, std::string sSearch, bool fRequireSig);
 void WriteCacheDouble(std::string sKey, double dValue);
 double ReadCacheDouble(std::string sKey);
+bool CheckTxMessageSignature(CTransactionRef tx, std::string sType);
 bool CheckAntiBotNetSignature(CTransactionRef tx, std::string sType, std::string sSolver);
 double GetVINCoinAge(int64_t nBlockTime, CTransactionRef tx, bool fDebug);
 CAmount GetTitheAmount(CTransactionRef ctx);
@@ -302,6 +320,8 @@ int GetWCGIdByCPID(std::string sSearch);
 uint256 ComputeRandomXTarget(uint256 hash, int64_t nPrevBlockTime, int64_t nBlockTime);
 std::string ReverseHex(std::string const & src);
 uint256 GetRandomXHash(std::string sHeaderHex, uint256 key, uint256 hashPrevBlock, int iThreadID);
+uint256 GetRandomXHash(const std::vector<unsigned char>& vchHeader, uint256 key, uint256 hashPrevBlock, int iThreadID);
+uint256 GetCachedRandomXHash(const std::vector<unsigned char>& vchHeader, uint256 key, uint256 hashPrevBlock, int iThreadID);
 std::string GenerateFaucetCode();
 
 #endif
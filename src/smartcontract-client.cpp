@@ -137,12 +137,15 @@ UniValue SentGSCCReport(int nHeight, std::string sMyCPK)
 		CBlock block;
 		if (ReadBlockFromDisk(block, pindex, consensusParams)) 
 		{
+			std::vector<char> vGSCSigned;
+			std::vector<char> vABNSigned;
+			CheckTxMessageSignatures(block, vGSCSigned, &vABNSigned);
 			for (unsigned int n = 0; n < block.vtx.size(); n++)
 			{
 				std::string sCampaignName;
 				std::string sDate = TimestampToHRDate(pindex->GetBlockTime());
 
-				if (block.vtx[n]->IsGSCTransmission() && CheckAntiBotNetSignature(block.vtx[n], "gsc", ""))
+				if (block.vtx[n]->IsGSCTransmission() && vGSCSigned[n])
 				{
 					std::string sCPK = GetTxCPK(block.vtx[n], sCampaignName);
 					double nCoinAge = 0;
@@ -159,7 +162,7 @@ UniValue SentGSCCReport(int nHeight, std::string sMyCPK)
 						results.push_back(Pair(block.vtx[n]->GetHash().GetHex(), sReport));
 					}
 				}
-				else if (block.vtx[n]->IsABN() && CheckAntiBotNetSignature(block.vtx[n], "abn", ""))
+				else if (block.vtx[n]->IsABN() && vABNSigned[n])
 				{
 					std::string sCPK = GetTxCPK(block.vtx[n], sCampaignName);
 					double nWeight = GetAntiBotNetWeight(pindex->GetBlockTime(), block.vtx[n], true, "");
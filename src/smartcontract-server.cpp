@@ -629,9 +629,11 @@ std::string AssessBlocks(int nHeight, bool fCreatingContract)
 		CBlock block;
 		if (ReadBlockFromDisk(block, pindex, consensusParams)) 
 		{
+			std::vector<char> vSigned;
+			CheckTxMessageSignatures(block, vSigned);
 			for (unsigned int n = 0; n < block.vtx.size(); n++)
 			{
-				if (block.vtx[n]->IsGSCTransmission() && CheckAntiBotNetSignature(block.vtx[n], "gsc", ""))
+				if (block.vtx[n]->IsGSCTransmission() && vSigned[n])
 				{
 					std::string sCampaignName;
 					std::string sCPK = GetTxCPK(block.vtx[n], sCampaignName);
@@ -12,6 +12,9 @@
 #include "net_processing.h"
 #include "netmessagemaker.h"
 
+#include <algorithm>
+#include <atomic>
+#include <ctype.h>
 #include <string>
 
 CSporkManager sporkManager;
@@ -34,6 +37,34 @@ std::map<int, int64_t> mapSporkDefaults = {
 	{SPORK_31_GSC_BUFFER,                      0},             // 0 BUFFER
 };
 
+bool CSporkSnapshot::CaseInsensitiveLess::operator()(const std::string& a, const std::string& b) const
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) {
+        return toupper(x) < toupper(y);
+    });
+}
+
+bool CSporkSnapshot::GetSporkValue(int nSporkID, int64_t& nValueRet) const
+{
+    auto it = mapSporkValues.find(nSporkID);
+    if (it == mapSporkValues.end()) return false;
+    nValueRet = it->second;
+    return true;
+}
+
+std::string CSporkSnapshot::GetString(const std::string& strName) const
+{
+    auto it = mapStringSporks.find(strName);
+    return it == mapStringSporks.end() ? std::string() : it->second.first;
+}
+
+double CSporkSnapshot::GetDouble(const std::string& strName, double nDefault) const
+{
+    auto it = mapStringSporks.find(strName);
+    if (it == mapStringSporks.end() || it->second.second == 0) return nDefault;
+    return it->second.second;
+}
+
 bool CSporkManager::SporkValueIsActive(int nSporkID, int64_t &nActiveValueRet) const
 {
     LOCK(cs);
@@ -62,6 +93,46 @@ void CSporkManager::Clear()
     mapSporksByHash.clear();
     // sporkPubKeyID and sporkPrivKey should be set in init.cpp,
     // we should not alter them here.
+    RebuildSnapshot();
+}
+
+void CSporkManager::RebuildSnapshot()
+{
+    AssertLockHeld(cs);
+    std::shared_ptr<CSporkSnapshot> snapshot = std::make_shared<CSporkSnapshot>();
+    snapshot->mapSporkValues = mapSporkDefaults;
+    for (const auto& pair : mapSporksActive) {
+        int64_t nActiveValue;
+        if (SporkValueIsActive(pair.first, nActiveValue)) {
+            snapshot->mapSporkValues[pair.first] = nActiveValue;
+        }
+    }
+    snapshot->mapStringSporks = mapStringSporks;
+    std::atomic_store(&sporkSnapshot, CSporkSnapshotPtr(snapshot));
+}
+
+CSporkSnapshotPtr CSporkManager::GetSnapshot()
+{
+    CSporkSnapshotPtr snapshot = std::atomic_load(&sporkSnapshot);
+    if (snapshot) return snapshot;
+    // sporkManager is constructed before mapSporkDefaults, so the first snapshot is built on demand
+    LOCK(cs);
+    if (!sporkSnapshot) RebuildSnapshot();
+    return std::atomic_load(&sporkSnapshot);
+}
+
+void CSporkManager::SetStringSpork(const std::string& strName, const std::string& strValue, double dValue)
+{
+    LOCK(cs);
+    mapStringSporks[strName] = std::make_pair(strValue, dValue);
+    RebuildSnapshot();
+}
+
+void CSporkManager::ClearStringSporks()
+{
+    LOCK(cs);
+    mapStringSporks.clear();
+    RebuildSnapshot();
 }
 
 void CSporkManager::CheckAndRemove()
@@ -110,6 +181,8 @@ void CSporkManager::CheckAndRemove()
         }
         ++itByHash;
     }
+
+    RebuildSnapshot();
 }
 
 void CSporkManager::ProcessSpork(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman)
@@ -177,6 +250,7 @@ void CSporkManager::ProcessSpork(CNode* pfrom, const std::string& strCommand, CD
             LOCK(cs); // make sure to not lock this together with cs_main
             mapSporksByHash[hash] = spork;
             mapSporksActive[spork.nSporkID][keyIDSigner] = spork;
+            RebuildSnapshot();
         }
         spork.Relay(connman);
 
@@ -241,6 +315,7 @@ bool CSporkManager::UpdateSpork(int nSporkID, int64_t nValue, CConnman& connman)
             LOCK(cs);
             mapSporksByHash[spork.GetHash()] = spork;
             mapSporksActive[nSporkID][keyIDSigner] = spork;
+            RebuildSnapshot();
         }
         spork.Relay(connman);
         return true;
@@ -251,34 +326,23 @@ bool CSporkManager::UpdateSpork(int nSporkID, int64_t nValue, CConnman& connman)
 
 bool CSporkManager::IsSporkActive(int nSporkID)
 {
-    LOCK(cs);
     int64_t nSporkValue = -1;
 
-    if (SporkValueIsActive(nSporkID, nSporkValue)) {
+    if (GetSnapshot()->GetSporkValue(nSporkID, nSporkValue)) {
         return nSporkValue < GetAdjustedTime();
     }
 
-    if (mapSporkDefaults.count(nSporkID)) {
-        return  mapSporkDefaults[nSporkID] < GetAdjustedTime();
-    }
-
     LogPrint("spork", "CSporkManager::IsSporkActive -- Unknown Spork ID %d\n", nSporkID);
     return false;
 }
 
 int64_t CSporkManager::GetSporkValue(int nSporkID)
 {
-    LOCK(cs);
-
     int64_t nSporkValue = -1;
-    if (SporkValueIsActive(nSporkID, nSporkValue)) {
+    if (GetSnapshot()->GetSporkValue(nSporkID, nSporkValue)) {
         return nSporkValue;
     }
 
-    if (mapSporkDefaults.count(nSporkID)) {
-        return mapSporkDefaults[nSporkID];
-    }
-
     LogPrint("spork", "CSporkManager::GetSporkValue -- Unknown Spork ID %d\n", nSporkID);
     return -1;
 }
@@ -359,7 +423,9 @@ bool CSporkManager::SetMinSporkKeys(int minSporkKeys)
         LogPrintf("CSporkManager::SetMinSporkKeys -- Invalid min spork signers number: %d\n", minSporkKeys);
         return false;
     }
+    LOCK(cs);
     nMinSporkKeys = minSporkKeys;
+    RebuildSnapshot();
     return true;
 }
 
@@ -11,11 +11,15 @@
 #include "utilstrencodings.h"
 #include "key.h"
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
 class CSporkMessage;
 class CSporkManager;
+class CSporkSnapshot;
+
+typedef std::shared_ptr<const CSporkSnapshot> CSporkSnapshotPtr;
 
 /*
     Don't ever reuse these IDs for other sporks
@@ -132,6 +136,43 @@ public:
     void Relay(CConnman& connman);
 };
 
+/**
+ * CSporkSnapshot is an immutable copy of every spork value known to the node:
+ * the CSporkManager sporks (resolved against the signer threshold and the
+ * defaults) and the string-keyed sporks set by spork transactions, with their
+ * numeric values parsed up front. String spork names are case-insensitive.
+ *
+ * The spork manager rebuilds the snapshot whenever a spork changes and swaps
+ * it in atomically, so readers can hold on to one without taking any lock.
+ */
+class CSporkSnapshot
+{
+public:
+    struct CaseInsensitiveLess {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+    typedef std::map<std::string, std::pair<std::string, double>, CaseInsensitiveLess> string_spork_map;
+
+    std::map<int, int64_t> mapSporkValues;
+    string_spork_map mapStringSporks;
+
+    /**
+     * GetSporkValue returns false if nSporkID is neither active nor has a default.
+     */
+    bool GetSporkValue(int nSporkID, int64_t& nValueRet) const;
+
+    /**
+     * GetString returns the value of a string spork, or an empty string.
+     */
+    std::string GetString(const std::string& strName) const;
+
+    /**
+     * GetDouble returns the numeric value of a string spork, or nDefault if it
+     * is not set or is zero.
+     */
+    double GetDouble(const std::string& strName, double nDefault) const;
+};
+
 /**
  * CSporkManager is a higher-level class which manages the node's spork
  * messages, rules for which sporks should be considered active/inactive, and
@@ -150,12 +191,23 @@ private:
     int nMinSporkKeys;
     CKey sporkPrivKey;
 
+    // string-keyed sporks from spork transactions, memory only
+    CSporkSnapshot::string_spork_map mapStringSporks;
+    // swapped with std::atomic_load/atomic_store
+    CSporkSnapshotPtr sporkSnapshot;
+
     /**
      * SporkValueIsActive is used to get the value agreed upon by the majority
      * of signed spork messages for a given Spork ID.
      */
     bool SporkValueIsActive(int nSporkID, int64_t& nActiveValueRet) const;
 
+    /**
+     * RebuildSnapshot publishes a new CSporkSnapshot. Must be called with cs
+     * held, after anything that can change a spork value.
+     */
+    void RebuildSnapshot();
+
 public:
 
     CSporkManager() {}
@@ -239,6 +291,23 @@ public:
      */
     int64_t GetSporkValue(int nSporkID);
 
+    /**
+     * GetSnapshot returns the current spork snapshot. It does not lock cs, so
+     * hot paths should fetch it once and read all the sporks they need from it.
+     */
+    CSporkSnapshotPtr GetSnapshot();
+
+    /**
+     * SetStringSpork stores a string-keyed spork accepted from a spork
+     * transaction. dValue is strValue parsed as a number (see cdbl).
+     */
+    void SetStringSpork(const std::string& strName, const std::string& strValue, double dValue);
+
+    /**
+     * ClearStringSporks removes all string-keyed sporks.
+     */
+    void ClearStringSporks();
+
     /**
      * GetSporkIDByName returns the internal Spork ID given the spork name.
      */
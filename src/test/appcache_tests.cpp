@@ -0,0 +1,93 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "rpcpog.h"
+#include "timedata.h"
+#include "utiltime.h"
+#include "validation.h"
+#include "test/test_coin.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(appcache_tests, BasicTestingSetup)
+
+static ApplicationCacheSectionStats SectionStats(const std::string& sSection)
+{
+    size_t nMaxBytes, nEvictableBytes;
+    std::map<std::string, ApplicationCacheSectionStats> mapSections = GetApplicationCacheStats(nMaxBytes, nEvictableBytes);
+    return mapSections.count(sSection) ? mapSections[sSection] : ApplicationCacheSectionStats();
+}
+
+BOOST_AUTO_TEST_CASE(appcache_clear_and_accounting)
+{
+    int64_t nNow = GetAdjustedTime();
+    WriteCache("prayer", "a", "first prayer", nNow);
+    WriteCache("prayer", "b", "second prayer", nNow);
+    WriteCache("cpk", "a", "consensus record", nNow);
+    BOOST_CHECK_EQUAL(ReadCache("PRAYER", "A"), "first prayer");
+    BOOST_CHECK_EQUAL(SectionStats("PRAYER").nEntries, 2U);
+    BOOST_CHECK(SectionStats("PRAYER").fEvictable);
+    BOOST_CHECK(!SectionStats("CPK").fEvictable);
+
+    // Overwriting keeps one entry, reading a missing key does not create one
+    WriteCache("prayer", "a", "updated", nNow);
+    BOOST_CHECK_EQUAL(ReadCache("prayer", "missing"), "");
+    BOOST_CHECK_EQUAL(SectionStats("PRAYER").nEntries, 2U);
+
+    // Clearing erases the section
+    ClearCache("prayer");
+    BOOST_CHECK_EQUAL(SectionStats("PRAYER").nEntries, 0U);
+    BOOST_CHECK_EQUAL(SectionStats("PRAYER").nBytes, 0U);
+    BOOST_CHECK(!mvApplicationCache.count(std::make_pair(std::string("PRAYER"), std::string("B"))));
+    BOOST_CHECK_EQUAL(SectionStats("CPK").nEntries, 1U);
+    ClearCache("cpk");
+}
+
+BOOST_AUTO_TEST_CASE(appcache_expiry)
+{
+    int64_t nNow = GetTime();
+    SetMockTime(nNow);
+    SetApplicationCacheLimits(0, 1000);
+    WriteCache("message", "recent", "x", nNow - 500);
+    WriteCache("message", "expired", "x", nNow - 2000);
+    WriteCache("dws-burn", "ancient", "x", nNow - 2000);
+    BOOST_CHECK_EQUAL(ReadCache("message", "recent"), "x");
+    BOOST_CHECK_EQUAL(ReadCache("message", "expired"), "");
+    BOOST_CHECK_EQUAL(ReadCache("dws-burn", "ancient"), "x");
+
+    SetMockTime(nNow + 1000);
+    ExpireApplicationCache();
+    BOOST_CHECK_EQUAL(ReadCache("message", "recent"), "");
+    BOOST_CHECK_EQUAL(ReadCache("dws-burn", "ancient"), "x");
+
+    ClearCache("dws-burn");
+    SetMockTime(0);
+    SetApplicationCacheLimits(DEFAULT_MAX_APPLICATION_CACHE << 20, DEFAULT_APPLICATION_CACHE_TTL * 86400);
+}
+
+BOOST_AUTO_TEST_CASE(appcache_memory_limit)
+{
+    const size_t nMaxBytes = 64 * 1024;
+    SetApplicationCacheLimits(nMaxBytes, 0);
+    int64_t nNow = GetAdjustedTime();
+    std::string sValue(200, 'p');
+    for (int i = 0; i < 1000; i++) {
+        WriteCache("prayer", "p" + std::to_string(i), sValue, nNow + i);
+        WriteCache("cpk", "c" + std::to_string(i), sValue, nNow + i);
+    }
+    size_t nLimit, nEvictableBytes;
+    GetApplicationCacheStats(nLimit, nEvictableBytes);
+    BOOST_CHECK(nEvictableBytes <= nMaxBytes);
+    BOOST_CHECK_EQUAL(SectionStats("PRAYER").nBytes, nEvictableBytes);
+    // The oldest prayers went first, consensus sections are never evicted
+    BOOST_CHECK_EQUAL(ReadCache("prayer", "p0"), "");
+    BOOST_CHECK_EQUAL(ReadCache("prayer", "p999"), sValue);
+    BOOST_CHECK_EQUAL(SectionStats("CPK").nEntries, 1000U);
+
+    ClearCache("prayer");
+    ClearCache("cpk");
+    SetApplicationCacheLimits(DEFAULT_MAX_APPLICATION_CACHE << 20, DEFAULT_APPLICATION_CACHE_TTL * 86400);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
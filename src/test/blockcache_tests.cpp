@@ -0,0 +1,67 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "blockcache.h"
+
+#include "serialize.h"
+#include "version.h"
+#include "test/test_coin.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockcache_tests, BasicTestingSetup)
+
+static std::shared_ptr<const CBlock> MakeCacheBlock(uint32_t nNonce)
+{
+    std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
+    pblock->nNonce = nNonce;
+    return pblock;
+}
+
+BOOST_AUTO_TEST_CASE(blockcache_lru)
+{
+    std::shared_ptr<const CBlock> pblock1 = MakeCacheBlock(1);
+    std::shared_ptr<const CBlock> pblock2 = MakeCacheBlock(2);
+    std::shared_ptr<const CBlock> pblock3 = MakeCacheBlock(3);
+    size_t nSize = ::GetSerializeSize(*pblock1, SER_NETWORK, PROTOCOL_VERSION);
+
+    CRecentBlockCache cache(nSize * 2);
+    cache.Insert(pblock1->GetHash(), pblock1, true);
+    cache.Insert(pblock2->GetHash(), pblock2, true);
+    BOOST_CHECK(cache.Get(pblock1->GetHash(), true) == pblock1);
+
+    // Block 2 is now the least recently used and gets evicted
+    cache.Insert(pblock3->GetHash(), pblock3, true);
+    BOOST_CHECK(cache.Get(pblock2->GetHash(), false) == nullptr);
+    BOOST_CHECK(cache.Get(pblock1->GetHash(), true) == pblock1);
+    BOOST_CHECK(cache.Get(pblock3->GetHash(), true) == pblock3);
+
+    CRecentBlockCache::Stats stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.nEntries, 2U);
+    BOOST_CHECK_EQUAL(stats.nBytes, nSize * 2);
+    BOOST_CHECK_EQUAL(stats.nHits, 3U);
+    BOOST_CHECK_EQUAL(stats.nMisses, 1U);
+
+    cache.SetMaxBytes(0);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 0U);
+    cache.Insert(pblock1->GetHash(), pblock1, true);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(blockcache_pow_checked)
+{
+    std::shared_ptr<const CBlock> pblock = MakeCacheBlock(1);
+    CRecentBlockCache cache(1 << 20);
+
+    // A block read without checking its proof of work is not handed to readers that require it
+    cache.Insert(pblock->GetHash(), pblock, false);
+    BOOST_CHECK(cache.Get(pblock->GetHash(), false) == pblock);
+    BOOST_CHECK(cache.Get(pblock->GetHash(), true) == nullptr);
+
+    cache.Insert(pblock->GetHash(), pblock, true);
+    BOOST_CHECK(cache.Get(pblock->GetHash(), true) == pblock);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
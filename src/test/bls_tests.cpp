@@ -154,4 +154,58 @@ BOOST_AUTO_TEST_CASE(batch_verifier_tests)
     Verify(msgs);
 }
 
+static void VerifySharded(std::vector<Message>& vec, CBLSWorker* worker, size_t maxShards, bool perMessageFallback)
+{
+    // minShardSize of 1 so that even the small test batches get split
+    CBLSShardedBatchVerifier<uint32_t, uint32_t> batchVerifier(false, perMessageFallback, maxShards, 1);
+
+    std::set<uint32_t> expectedBadMessages;
+    std::set<uint32_t> expectedBadSources;
+    for (auto& m : vec) {
+        if (!m.valid) {
+            expectedBadMessages.emplace(m.msgId);
+            expectedBadSources.emplace(m.sourceId);
+        }
+
+        batchVerifier.PushMessage(m.sourceId, m.msgId, m.msgHash, m.sig, m.pk);
+    }
+
+    batchVerifier.Verify(worker);
+
+    BOOST_CHECK(batchVerifier.badSources == expectedBadSources);
+
+    if (perMessageFallback) {
+        BOOST_CHECK(batchVerifier.badMessages == expectedBadMessages);
+    } else {
+        BOOST_CHECK(batchVerifier.badMessages.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sharded_batch_verifier_tests)
+{
+    CBLSWorker worker;
+    worker.Start();
+
+    std::vector<Message> msgs;
+    for (uint32_t i = 1; i <= 20; i++) {
+        AddMessage(msgs, i % 7, i, i, true);
+    }
+    for (size_t maxShards : {1, 3, 8}) {
+        VerifySharded(msgs, &worker, maxShards, true);
+        VerifySharded(msgs, nullptr, maxShards, false);
+    }
+
+    // invalid sigs in two different sources, one of them also sending a valid duplicate of another source's message
+    AddMessage(msgs, 2, 21, 21, false);
+    AddMessage(msgs, 5, 22, 22, false);
+    AddMessage(msgs, 5, 23, 3, true);
+    for (size_t maxShards : {1, 3, 8}) {
+        VerifySharded(msgs, &worker, maxShards, true);
+        VerifySharded(msgs, &worker, maxShards, false);
+        VerifySharded(msgs, nullptr, maxShards, true);
+    }
+
+    worker.Stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
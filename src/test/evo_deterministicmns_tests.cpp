@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "test/test_coin.h"
+#include "test/test_random.h"
 
 #include "script/interpreter.h"
 #include "script/standard.h"
@@ -402,3 +403,116 @@ BOOST_FIXTURE_TEST_CASE(dip3_protx, TestChainDIP3Setup)
     const_cast<Consensus::Params&>(Params().GetConsensus()).DIP0003EnforcementHeight = DIP0003EnforcementHeightBackup;
 }
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(evo_dip3_payment_queue_tests, BasicTestingSetup)
+
+static std::vector<CDeterministicMNCPtr> SortedPayeesBruteForce(const CDeterministicMNList& mnList)
+{
+    std::vector<std::pair<std::pair<int, uint256>, CDeterministicMNCPtr>> v;
+    mnList.ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
+        int height = dmn->pdmnState->nLastPaidHeight;
+        if (dmn->pdmnState->nPoSeRevivedHeight != -1 && dmn->pdmnState->nPoSeRevivedHeight > height) {
+            height = dmn->pdmnState->nPoSeRevivedHeight;
+        } else if (height == 0) {
+            height = dmn->pdmnState->nRegisteredHeight;
+        }
+        v.emplace_back(std::make_pair(height, dmn->proTxHash), dmn);
+    });
+    std::sort(v.begin(), v.end(), [](const std::pair<std::pair<int, uint256>, CDeterministicMNCPtr>& a, const std::pair<std::pair<int, uint256>, CDeterministicMNCPtr>& b) {
+        return a.first < b.first;
+    });
+    std::vector<CDeterministicMNCPtr> ret;
+    for (const auto& p : v) {
+        ret.emplace_back(p.second);
+    }
+    return ret;
+}
+
+static void CheckPaymentQueue(const CDeterministicMNList& mnList)
+{
+    auto expected = SortedPayeesBruteForce(mnList);
+    auto projected = mnList.GetProjectedMNPayees(mnList.GetAllMNsCount());
+    BOOST_CHECK_EQUAL(mnList.GetValidMNsCount(), expected.size());
+    BOOST_REQUIRE_EQUAL(projected.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        BOOST_CHECK(projected[i]->proTxHash == expected[i]->proTxHash);
+    }
+    auto payee = mnList.GetMNPayee();
+    BOOST_CHECK(expected.empty() ? payee == nullptr : payee->proTxHash == expected[0]->proTxHash);
+}
+
+BOOST_AUTO_TEST_CASE(dip3_payment_queue)
+{
+    CDeterministicMNList mnList(uint256(), 1000, 0);
+    std::vector<uint256> proTxHashes;
+    for (int i = 0; i < 50; i++) {
+        auto dmn = std::make_shared<CDeterministicMN>();
+        dmn->proTxHash = GetRandHash();
+        dmn->internalId = i;
+        dmn->collateralOutpoint = COutPoint(GetRandHash(), 0);
+        auto state = std::make_shared<CDeterministicMNState>();
+        state->keyIDOwner = CKeyID(uint160(std::vector<unsigned char>(dmn->proTxHash.begin(), dmn->proTxHash.begin() + 20)));
+        // some share a registration height, so the proTxHash tie break matters
+        state->nRegisteredHeight = 100 + insecure_rand() % 20;
+        dmn->pdmnState = state;
+        mnList.AddMN(dmn);
+        proTxHashes.emplace_back(dmn->proTxHash);
+    }
+    CheckPaymentQueue(mnList);
+
+    for (int nHeight = 1001; nHeight < 1300; nHeight++) {
+        // pay the next one, like BuildNewListFromBlock does
+        auto payee = mnList.GetMNPayee();
+        auto newState = std::make_shared<CDeterministicMNState>(*payee->pdmnState);
+        newState->nLastPaidHeight = nHeight;
+        mnList.UpdateMN(payee->proTxHash, newState);
+
+        // and randomly ban, revive or remove others
+        auto dmn = mnList.GetMN(proTxHashes[insecure_rand() % proTxHashes.size()]);
+        if (dmn) {
+            newState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
+            switch (insecure_rand() % 4) {
+            case 0:
+                newState->nPoSeBanHeight = nHeight;
+                break;
+            case 1:
+                newState->nPoSeBanHeight = -1;
+                newState->nPoSeRevivedHeight = nHeight;
+                break;
+            case 2:
+                newState->nPoSePenalty++;
+                break;
+            case 3:
+                if (nHeight % 10 == 0) {
+                    mnList.RemoveMN(dmn->proTxHash);
+                    newState = nullptr;
+                }
+                break;
+            }
+            if (newState) {
+                mnList.UpdateMN(dmn->proTxHash, newState);
+            }
+        }
+        CheckPaymentQueue(mnList);
+    }
+
+    // copies taken before an update keep their own queue
+    auto copy = mnList;
+    auto payee = mnList.GetMNPayee();
+    auto newState = std::make_shared<CDeterministicMNState>(*payee->pdmnState);
+    newState->nLastPaidHeight = 2000;
+    mnList.UpdateMN(payee->proTxHash, newState);
+    BOOST_CHECK(copy.GetMNPayee()->proTxHash == payee->proTxHash);
+    CheckPaymentQueue(copy);
+    CheckPaymentQueue(mnList);
+
+    // and the queue is rebuilt when unserializing
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << mnList;
+    CDeterministicMNList mnList2;
+    ss >> mnList2;
+    CheckPaymentQueue(mnList2);
+    BOOST_CHECK(mnList2.GetMNPayee()->proTxHash == mnList.GetMNPayee()->proTxHash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
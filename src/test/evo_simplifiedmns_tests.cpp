@@ -12,28 +12,33 @@
 
 BOOST_FIXTURE_TEST_SUITE(evo_simplifiedmns_tests, BasicTestingSetup)
 
-BOOST_AUTO_TEST_CASE(simplifiedmns_merkleroots)
+static CSimplifiedMNListEntry MakeEntry(size_t i)
 {
-    std::vector<CSimplifiedMNListEntry> entries;
-    for (size_t i = 0; i < 15; i++) {
-        CSimplifiedMNListEntry smle;
-        smle.proRegTxHash.SetHex(strprintf("%064x", i));
-        smle.confirmedHash.SetHex(strprintf("%064x", i));
+    CSimplifiedMNListEntry smle;
+    smle.proRegTxHash.SetHex(strprintf("%064x", i));
+    smle.confirmedHash.SetHex(strprintf("%064x", i));
 
-        std::string ip = strprintf("%d.%d.%d.%d", 0, 0, 0, i);
-        Lookup(ip.c_str(), smle.service, i, false);
+    std::string ip = strprintf("%d.%d.%d.%d", 0, 0, 0, i);
+    Lookup(ip.c_str(), smle.service, i, false);
 
-        uint8_t skBuf[CBLSSecretKey::SerSize];
-        memset(skBuf, 0, sizeof(skBuf));
-        skBuf[0] = (uint8_t)i;
-        CBLSSecretKey sk;
-        sk.SetBuf(skBuf, sizeof(skBuf));
+    uint8_t skBuf[CBLSSecretKey::SerSize];
+    memset(skBuf, 0, sizeof(skBuf));
+    skBuf[0] = (uint8_t)i;
+    CBLSSecretKey sk;
+    sk.SetBuf(skBuf, sizeof(skBuf));
 
-        smle.pubKeyOperator.Set(sk.GetPublicKey());
-        smle.keyIDVoting.SetHex(strprintf("%040x", i));
-        smle.isValid = true;
+    smle.pubKeyOperator.Set(sk.GetPublicKey());
+    smle.keyIDVoting.SetHex(strprintf("%040x", i));
+    smle.isValid = true;
 
-        entries.emplace_back(smle);
+    return smle;
+}
+
+BOOST_AUTO_TEST_CASE(simplifiedmns_merkleroots)
+{
+    std::vector<CSimplifiedMNListEntry> entries;
+    for (size_t i = 0; i < 15; i++) {
+        entries.emplace_back(MakeEntry(i));
     }
 
     std::vector<std::string> expectedHashes = {
@@ -70,4 +75,48 @@ BOOST_AUTO_TEST_CASE(simplifiedmns_merkleroots)
 
     BOOST_CHECK(expectedMerkleRoot == calculatedMerkleRoot);
 }
+
+BOOST_AUTO_TEST_CASE(simplifiedmns_incremental_merkleroot)
+{
+    CSimplifiedMNListMerkleTree tree;
+    std::vector<CSimplifiedMNListEntry> entries;
+
+    auto check = [&]() {
+        CSimplifiedMNList sml(entries);
+        bool mutated = true;
+        BOOST_CHECK(tree.Update(sml, &mutated) == sml.CalcMerkleRoot(nullptr));
+        BOOST_CHECK(!mutated);
+    };
+
+    check();
+    for (size_t i = 0; i < 15; i++) {
+        entries.emplace_back(MakeEntry(i));
+    }
+    check();
+    // unchanged list
+    check();
+
+    // changed entries without moving any positions
+    entries[0].isValid = false;
+    check();
+    entries[7].confirmedHash.SetHex(strprintf("%064x", 100));
+    entries[14].isValid = false;
+    check();
+
+    // removed and added entries
+    entries.erase(entries.begin() + 3);
+    check();
+    entries.emplace_back(MakeEntry(20));
+    entries.emplace_back(MakeEntry(21));
+    entries[5].isValid = false;
+    check();
+
+    // down to a single entry and back to nothing
+    entries.resize(1);
+    check();
+    entries[0].isValid = true;
+    check();
+    entries.clear();
+    check();
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,10 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "hash.h"
+#include "crypto/x11.h"
+#include "primitives/block.h"
+#include "random.h"
+#include "test/test_random.h"
 #include "utilstrencodings.h"
 #include "test/test_coin.h"
 
@@ -149,4 +153,30 @@ BOOST_AUTO_TEST_CASE(siphash)
     BOOST_CHECK_EQUAL(SipHashUint256(1, 2, ss.GetHash()), 0x79751e980c2a0a35ULL);
 }
 
+BOOST_AUTO_TEST_CASE(x11_optimized_and_batch)
+{
+    // Random headers, hashed per header with the portable stages
+    std::vector<CBlockHeader> headers(150);
+    std::vector<uint256> vExpected;
+    X11AutoDetect(false);
+    for (CBlockHeader& header : headers) {
+        header.nVersion = insecure_rand();
+        header.hashPrevBlock = GetRandHash();
+        header.hashMerkleRoot = GetRandHash();
+        header.nTime = insecure_rand();
+        header.nBits = insecure_rand();
+        header.nNonce = insecure_rand();
+        vExpected.push_back(header.GetHash());
+    }
+    BOOST_CHECK(GetBlockHeaderHashes(headers) == vExpected);
+
+    // The optimized stages, if any, must agree both per header and batched
+    X11AutoDetect();
+    for (size_t i = 0; i < headers.size(); i++) {
+        BOOST_CHECK(headers[i].GetHash() == vExpected[i]);
+    }
+    BOOST_CHECK(GetBlockHeaderHashes(headers) == vExpected);
+    BOOST_CHECK(GetBlockHeaderHashes(std::vector<CBlockHeader>()).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
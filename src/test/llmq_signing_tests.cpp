@@ -0,0 +1,116 @@
+// Copyright (c) 2019 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "test/test_coin.h"
+
+#include "dbwrapper.h"
+#include "llmq/quorums_signing.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+static const Consensus::LLMQType llmqType = Consensus::LLMQ_50_60;
+
+static uint256 MakeHash(int i)
+{
+    uint256 h;
+    h.SetHex(strprintf("%064x", i));
+    return h;
+}
+
+static bool HasVoteInDb(CDBWrapper& db, const uint256& id, uint256& msgHashRet)
+{
+    return db.Read(std::make_tuple(std::string("rs_v"), (uint8_t)llmqType, id), msgHashRet);
+}
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(recovered_sigs_db_votes)
+{
+    CDBWrapper db("", 1 << 20, true, false);
+    uint256 id = MakeHash(1);
+    uint256 msgHash = MakeHash(2);
+    uint256 msgHash2;
+
+    {
+        CRecoveredSigsDb sigsDb(db);
+
+        // caches the negative result
+        BOOST_CHECK(!sigsDb.HasVotedOnId(llmqType, id));
+        BOOST_CHECK(!sigsDb.GetVoteForId(llmqType, id, msgHash2));
+
+        // pending votes are visible right away and replace the cached negative result...
+        sigsDb.WriteVoteForId(llmqType, id, msgHash);
+        BOOST_CHECK(sigsDb.HasVotedOnId(llmqType, id));
+        BOOST_CHECK(sigsDb.GetVoteForId(llmqType, id, msgHash2));
+        BOOST_CHECK(msgHash2 == msgHash);
+
+        // ...but only reach the db when flushed
+        BOOST_CHECK(!HasVoteInDb(db, id, msgHash2));
+        sigsDb.FlushPendingVotes();
+        BOOST_CHECK(HasVoteInDb(db, id, msgHash2));
+        BOOST_CHECK(msgHash2 == msgHash);
+
+        // still answered from the cache after the flush
+        msgHash2.SetNull();
+        BOOST_CHECK(sigsDb.GetVoteForId(llmqType, id, msgHash2));
+        BOOST_CHECK(msgHash2 == msgHash);
+
+        // outdated votes are removed from the db and the cache
+        sigsDb.CleanupOldVotes(-10);
+        BOOST_CHECK(!HasVoteInDb(db, id, msgHash2));
+        BOOST_CHECK(!sigsDb.HasVotedOnId(llmqType, id));
+
+        // pending votes are flushed on destruction
+        sigsDb.WriteVoteForId(llmqType, MakeHash(3), msgHash);
+    }
+    BOOST_CHECK(HasVoteInDb(db, MakeHash(3), msgHash2));
+    BOOST_CHECK(msgHash2 == msgHash);
+
+    {
+        // a fresh instance has cold caches and must find the flushed vote in the db
+        CRecoveredSigsDb sigsDb(db);
+        msgHash2.SetNull();
+        BOOST_CHECK(sigsDb.GetVoteForId(llmqType, MakeHash(3), msgHash2));
+        BOOST_CHECK(msgHash2 == msgHash);
+        BOOST_CHECK(sigsDb.HasVotedOnId(llmqType, MakeHash(3)));
+        BOOST_CHECK(!sigsDb.HasVotedOnId(llmqType, id));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(recovered_sigs_db_sigs)
+{
+    CDBWrapper db("", 1 << 20, true, false);
+    CRecoveredSigsDb sigsDb(db);
+
+    CRecoveredSig recSig;
+    recSig.llmqType = llmqType;
+    recSig.quorumHash = MakeHash(1);
+    recSig.id = MakeHash(2);
+    recSig.msgHash = MakeHash(3);
+    recSig.sig.Set(CBLSSignature());
+    recSig.UpdateHash();
+
+    BOOST_CHECK(!sigsDb.HasRecoveredSigForId(llmqType, recSig.id));
+    BOOST_CHECK(!sigsDb.HasRecoveredSig(llmqType, recSig.id, recSig.msgHash));
+
+    // the negative results cached above must not hide the new recSig
+    sigsDb.WriteRecoveredSigs({recSig});
+    BOOST_CHECK(sigsDb.HasRecoveredSigForId(llmqType, recSig.id));
+    BOOST_CHECK(sigsDb.HasRecoveredSigForHash(recSig.GetHash()));
+    BOOST_CHECK(sigsDb.HasRecoveredSig(llmqType, recSig.id, recSig.msgHash));
+    BOOST_CHECK(!sigsDb.HasRecoveredSig(llmqType, recSig.id, MakeHash(4)));
+
+    CRecoveredSig recSig2;
+    BOOST_CHECK(sigsDb.GetRecoveredSigById(llmqType, recSig.id, recSig2));
+    BOOST_CHECK(recSig2.GetHash() == recSig.GetHash());
+
+    sigsDb.RemoveRecoveredSig(llmqType, recSig.id);
+    BOOST_CHECK(!sigsDb.HasRecoveredSigForId(llmqType, recSig.id));
+    BOOST_CHECK(!sigsDb.HasRecoveredSigForHash(recSig.GetHash()));
+    BOOST_CHECK(!sigsDb.HasRecoveredSig(llmqType, recSig.id, recSig.msgHash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
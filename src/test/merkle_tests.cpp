@@ -133,4 +133,27 @@ BOOST_AUTO_TEST_CASE(merkle_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(merkle_coinbase_branch)
+{
+    for (int ntx = 1; ntx <= 33; ntx++) {
+        CBlock block;
+        block.vtx.resize(ntx);
+        for (int j = 0; j < ntx; j++) {
+            CMutableTransaction mtx;
+            mtx.nLockTime = j;
+            block.vtx[j] = MakeTransactionRef(std::move(mtx));
+        }
+        std::vector<uint256> vBranch = BlockMerkleBranch(block, 0);
+        BOOST_CHECK(BlockMerkleRootFromCoinbaseBranch(block, vBranch) == BlockMerkleRoot(block));
+        // The branch does not depend on the coinbase, so it stays valid when only the coinbase changes
+        for (int nExtraNonce = 1; nExtraNonce <= 3; nExtraNonce++) {
+            CMutableTransaction coinbase(*block.vtx[0]);
+            coinbase.vin.resize(1);
+            coinbase.vin[0].scriptSig = CScript() << nExtraNonce;
+            block.vtx[0] = MakeTransactionRef(std::move(coinbase));
+            BOOST_CHECK(BlockMerkleRootFromCoinbaseBranch(block, vBranch) == BlockMerkleRoot(block));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
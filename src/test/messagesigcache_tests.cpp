@@ -0,0 +1,101 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "messagesigcache.h"
+
+#include "base58.h"
+#include "hash.h"
+#include "key.h"
+#include "rpcpog.h"
+#include "script/standard.h"
+#include "utilstrencodings.h"
+#include "validation.h"
+#include "test/test_coin.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(messagesigcache_tests, BasicTestingSetup)
+
+static uint256 MessageHash(const std::string& strMessage)
+{
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << strMessageMagic;
+    ss << strMessage;
+    return ss.GetHash();
+}
+
+BOOST_AUTO_TEST_CASE(messagesigcache_entries)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CKey key2;
+    key2.MakeNewKey(true);
+    uint256 hashMessage = MessageHash("<abnmsg>entries</abnmsg>");
+    std::vector<unsigned char> vchSig;
+    BOOST_CHECK(key.SignCompact(hashMessage, vchSig));
+
+    BOOST_CHECK(!GetCachedMessageSignature(key.GetPubKey().GetID(), hashMessage, vchSig));
+    AddCachedMessageSignature(key.GetPubKey().GetID(), hashMessage, vchSig);
+    BOOST_CHECK(GetCachedMessageSignature(key.GetPubKey().GetID(), hashMessage, vchSig));
+
+    // Any change to the triple is a different entry
+    BOOST_CHECK(!GetCachedMessageSignature(key2.GetPubKey().GetID(), hashMessage, vchSig));
+    BOOST_CHECK(!GetCachedMessageSignature(key.GetPubKey().GetID(), MessageHash("other"), vchSig));
+    vchSig[10] ^= 1;
+    BOOST_CHECK(!GetCachedMessageSignature(key.GetPubKey().GetID(), hashMessage, vchSig));
+}
+
+BOOST_AUTO_TEST_CASE(messagesigcache_checkstakesignature)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CKey key2;
+    key2.MakeNewKey(true);
+    std::string strMessage = "<abnmsg>stake</abnmsg>";
+    std::vector<unsigned char> vchSig;
+    BOOST_CHECK(key.SignCompact(MessageHash(strMessage), vchSig));
+    std::string strSig = EncodeBase64(vchSig.data(), vchSig.size());
+    std::string strAddress = CBitcoinAddress(key.GetPubKey().GetID()).ToString();
+    std::string strAddress2 = CBitcoinAddress(key2.GetPubKey().GetID()).ToString();
+    std::string strError;
+
+    // A failed check against another address still caches the signer
+    BOOST_CHECK(!CheckStakeSignature(strAddress2, strSig, strMessage, strError));
+    BOOST_CHECK(GetCachedMessageSignature(key.GetPubKey().GetID(), MessageHash(strMessage), vchSig));
+
+    // Hits and misses give the same answers as a full verification
+    for (int i = 0; i < 2; i++) {
+        BOOST_CHECK(CheckStakeSignature(strAddress, strSig, strMessage, strError));
+        BOOST_CHECK(!CheckStakeSignature(strAddress2, strSig, strMessage, strError));
+        BOOST_CHECK(!CheckStakeSignature(strAddress, strSig, strMessage + " ", strError));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(txmessage_signature_outputs)
+{
+    std::vector<CKey> keys(4);
+    CMutableTransaction mtx;
+    mtx.vout.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        keys[i].MakeNewKey(true);
+        mtx.vout[i].scriptPubKey = GetScriptForDestination(keys[i].GetPubKey().GetID());
+    }
+    std::string strMessage = "<MT>GSCTransmission</MT>outputs";
+    CKey outsider;
+    outsider.MakeNewKey(true);
+    for (int nSigner = 0; nSigner < 3; nSigner++) {
+        // Signed by the owner of the third output, then of the first, then by a key that owns none
+        const CKey& signer = nSigner == 0 ? keys[2] : (nSigner == 1 ? keys[0] : outsider);
+        std::vector<unsigned char> vchSig;
+        BOOST_CHECK(signer.SignCompact(MessageHash(strMessage), vchSig));
+        mtx.vout[0].sTxOutMessage = "<abnmsg>" + strMessage + "</abnmsg><gscsig>" + EncodeBase64(vchSig.data(), vchSig.size()) + "</gscsig>";
+        CTransactionRef tx = MakeTransactionRef(mtx);
+        for (int i = 0; i < 2; i++) {
+            BOOST_CHECK_EQUAL(CheckTxMessageSignature(tx, "gsc"), nSigner != 2);
+            BOOST_CHECK(!CheckTxMessageSignature(tx, "abn"));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "base58.h"
 #include "chainparams.h"
 #include "coins.h"
 #include "consensus/consensus.h"
@@ -13,10 +14,14 @@
 #include "policy/policy.h"
 #include "pubkey.h"
 #include "script/standard.h"
+#include "spork.h"
 #include "txmempool.h"
 #include "uint256.h"
 #include "util.h"
 #include "utilstrencodings.h"
+#include "validationinterface.h"
+
+#include "llmq/quorums_chainlocks.h"
 
 #include "test/test_coin.h"
 
@@ -436,4 +441,172 @@ BOOST_AUTO_TEST_CASE(CreateNewBlock_validity)
     fCheckpointsEnabled = true;
 }
 
+static CMutableTransaction CandidateTx(const uint256& hashPrev, CAmount nValue)
+{
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].prevout = COutPoint(hashPrev, 0);
+    tx.vin[0].scriptSig = CScript() << OP_1;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+    tx.vout[0].nValue = nValue;
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(CreateNewBlock_candidate)
+{
+    TestMemPoolEntryHelper entry;
+    BlockAssembler::Options options;
+    options.blockMinFeeRate = blockMinFeeRate;
+    options.fUseCandidate = true;
+    BlockAssembler assembler(Params(), options);
+    mempool.clear();
+    blockCandidate.Invalidate();
+
+    uint256 hashTip = GetRandHash();
+    CMutableTransaction txLow = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txHigh = CandidateTx(GetRandHash(), 10 * COIN);
+    mempool.addUnchecked(txLow.GetHash(), entry.Fee(1000).FromTx(txLow));
+    mempool.addUnchecked(txHigh.GetHash(), entry.Fee(10000).FromTx(txHigh));
+
+    std::unique_ptr<CBlockTemplate> pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txHigh.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txLow.GetHash());
+
+    // Arrivals are appended behind the previous selection, children after their parents
+    CMutableTransaction txNew = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txChild = CandidateTx(txLow.GetHash(), 9 * COIN);
+    mempool.addUnchecked(txNew.GetHash(), entry.Fee(50000).FromTx(txNew));
+    mempool.addUnchecked(txChild.GetHash(), entry.Fee(5000).FromTx(txChild));
+    pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 5);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txHigh.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txLow.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[3]->GetHash() == txNew.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[4]->GetHash() == txChild.GetHash());
+
+    // Removing a transaction takes its descendants out of the next template too
+    mempool.removeRecursive(txLow);
+    pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txHigh.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txNew.GetHash());
+
+    // A new tip selects from scratch, in feerate order
+    pblocktemplate = assembler.SelectTransactions(GetRandHash(), 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txNew.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txHigh.GetHash());
+
+    blockCandidate.Invalidate();
+    mempool.clear();
+}
+
+BOOST_AUTO_TEST_CASE(CreateNewBlock_single_tx_packages)
+{
+    // Transactions without unconfirmed ancestors or descendants take a shortcut
+    // past the package walks, they must still be ordered against real packages
+    TestMemPoolEntryHelper entry;
+    BlockAssembler::Options options;
+    options.blockMinFeeRate = blockMinFeeRate;
+    BlockAssembler assembler(Params(), options);
+    mempool.clear();
+
+    // All transactions have the same size, so fees compare like feerates
+    CMutableTransaction txSingle = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txParent = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txChild = CandidateTx(txParent.GetHash(), 9 * COIN);
+    CMutableTransaction txParent2 = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txChild2 = CandidateTx(txParent2.GetHash(), 9 * COIN);
+    mempool.addUnchecked(txSingle.GetHash(), entry.Fee(3000).FromTx(txSingle));
+    mempool.addUnchecked(txParent.GetHash(), entry.Fee(1000).FromTx(txParent));
+    mempool.addUnchecked(txChild.GetHash(), entry.Fee(10000).FromTx(txChild));
+    mempool.addUnchecked(txParent2.GetHash(), entry.Fee(5000).FromTx(txParent2));
+    mempool.addUnchecked(txChild2.GetHash(), entry.Fee(2000).FromTx(txChild2));
+
+    // txChild pays for txParent (5500 per tx), txParent2 goes in on its own ahead
+    // of txSingle, which in turn goes ahead of txChild2 once txChild2 no longer
+    // gets txParent2's fee counted with its own
+    std::unique_ptr<CBlockTemplate> pblocktemplate = assembler.SelectTransactions(GetRandHash(), 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 6);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txParent.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txChild.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[3]->GetHash() == txParent2.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[4]->GetHash() == txSingle.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[5]->GetHash() == txChild2.GetHash());
+
+    mempool.clear();
+}
+
+static void SetLLMQSporks(bool fActive)
+{
+    int64_t nValue = fActive ? 0 : 4070908800ULL;
+    BOOST_CHECK(sporkManager.UpdateSpork(SPORK_19_CHAINLOCKS_ENABLED, nValue, *g_connman));
+    BOOST_CHECK(sporkManager.UpdateSpork(SPORK_20_INSTANTSEND_LLMQ_BASED, nValue, *g_connman));
+    llmq::chainLocksHandler->CheckActiveState();
+}
+
+BOOST_AUTO_TEST_CASE(CreateNewBlock_candidate_islock)
+{
+    CKey sporkKey;
+    sporkKey.MakeNewKey(false);
+    CBitcoinAddress sporkAddress;
+    sporkAddress.Set(sporkKey.GetPubKey().GetID());
+    sporkManager.SetSporkAddress(sporkAddress.ToString());
+    sporkManager.SetPrivKey(CBitcoinSecret(sporkKey).ToString());
+
+    // With LLMQ based InstantSend, transactions are only safe to mine once they are
+    // IS-locked or were seen WAIT_FOR_ISLOCK_TIMEOUT (10 minutes) ago. Passing the
+    // timeout stands in for the IS lock arriving, both flip IsTxSafeForMining
+    int64_t nTime = GetTime();
+    SetMockTime(nTime - 10 * 60);
+    SetLLMQSporks(true);
+
+    TestMemPoolEntryHelper entry;
+    BlockAssembler::Options options;
+    options.blockMinFeeRate = blockMinFeeRate;
+    options.fUseCandidate = true;
+    BlockAssembler assembler(Params(), options);
+    mempool.clear();
+    blockCandidate.Invalidate();
+
+    auto addTx = [&](const CMutableTransaction& tx, CAmount nFee, int64_t nTimeSeen) {
+        mempool.addUnchecked(tx.GetHash(), entry.Fee(nFee).Time(nTimeSeen).FromTx(tx));
+        llmq::chainLocksHandler->SyncTransaction(tx, nullptr, CMainSignals::SYNC_TRANSACTION_NOT_IN_BLOCK);
+    };
+
+    uint256 hashTip = GetRandHash();
+    CMutableTransaction txSafe = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txLocked = CandidateTx(GetRandHash(), 10 * COIN);
+    CMutableTransaction txLockedLate = CandidateTx(GetRandHash(), 10 * COIN);
+    addTx(txSafe, 1000, nTime - 10 * 60);
+    SetMockTime(nTime);
+    addTx(txLocked, 5000, nTime);
+
+    // The full selection skips the transaction that is not locked yet...
+    std::unique_ptr<CBlockTemplate> pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 2);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txSafe.GetHash());
+
+    // ...and so does the extension for the ones arriving after it
+    addTx(txLockedLate, 10000, nTime);
+    pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 2);
+
+    // Both are appended once they are safe, without another full selection (which
+    // would have ordered them by feerate)
+    SetMockTime(nTime + 10 * 60);
+    pblocktemplate = assembler.SelectTransactions(hashTip, 2, 0);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 4);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == txSafe.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == txLocked.GetHash());
+    BOOST_CHECK(pblocktemplate->block.vtx[3]->GetHash() == txLockedLate.GetHash());
+
+    blockCandidate.Invalidate();
+    mempool.clear();
+    SetLLMQSporks(false);
+    SetMockTime(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
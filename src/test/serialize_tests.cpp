@@ -5,6 +5,8 @@
 #include "serialize.h"
 #include "streams.h"
 #include "hash.h"
+#include "chain.h"
+#include "utilstrencodings.h"
 #include "test/test_coin.h"
 
 #include <stdint.h>
@@ -414,4 +416,60 @@ BOOST_AUTO_TEST_CASE(class_methods)
     BOOST_CHECK(methodtest3 == methodtest4);
 }
 
+BOOST_AUTO_TEST_CASE(randomx_header)
+{
+    std::vector<unsigned char> vchHeader = ParseHex("0102030405060708090a0b0c0d0e0f10abcdef");
+    std::string strCanonical = "<rxheader>" + HexStr(vchHeader) + "</rxheader>";
+
+    // Canonical strings are kept as raw bytes and reproduce the exact string
+    CRandomXHeader rx = CRandomXHeader::FromString(strCanonical);
+    BOOST_CHECK_EQUAL(rx.GetEncoding(), CRandomXHeader::RX_ENCODING_BINARY);
+    BOOST_CHECK(rx.GetBytes() == vchHeader);
+    BOOST_CHECK_EQUAL(rx.ToString(), strCanonical);
+    BOOST_CHECK(CRandomXHeader::FromBytes(vchHeader) == rx);
+
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << rx;
+    BOOST_CHECK_EQUAL(ss.size(), 1 + 1 + vchHeader.size());
+    CRandomXHeader rx2;
+    ss >> rx2;
+    BOOST_CHECK(rx == rx2);
+
+    // Non-canonical strings decode like ExtractXML + ParseHex and are kept verbatim
+    std::string strLegacy = "junk<rxheader>0102 0A</rxheader>";
+    CRandomXHeader rxLegacy = CRandomXHeader::FromString(strLegacy);
+    BOOST_CHECK_EQUAL(rxLegacy.GetEncoding(), CRandomXHeader::RX_ENCODING_LEGACY);
+    BOOST_CHECK(rxLegacy.GetBytes() == ParseHex("0102 0A"));
+    BOOST_CHECK_EQUAL(rxLegacy.ToString(), strLegacy);
+    ss << rxLegacy;
+    ss >> rx2;
+    BOOST_CHECK(rxLegacy == rx2);
+
+    CRandomXHeader rxNull = CRandomXHeader::FromString("");
+    BOOST_CHECK(rxNull.IsNull());
+    BOOST_CHECK(rxNull.ToString().empty());
+    BOOST_CHECK(rxNull.GetBytes().empty());
+}
+
+BOOST_AUTO_TEST_CASE(disk_block_index_randomx_versions)
+{
+    CBlockHeader header;
+    header.nVersion = 0x50000000;
+    header.nBits = 0x1d00ffff;
+    header.RandomXData = "<rxheader>" + HexStr(ParseHex("deadbeef")) + "</rxheader>";
+    CBlockIndex index(header);
+    uint256 hash = header.GetHash();
+    index.phashBlock = &hash;
+
+    // Records written by older clients carry the legacy string and must still load
+    for (int nVersion : {DISK_BLOCK_INDEX_RX_COMPACT_VERSION - 1, DISK_BLOCK_INDEX_RX_COMPACT_VERSION}) {
+        CDataStream ss(SER_DISK, nVersion);
+        ss << CDiskBlockIndex(&index);
+        CDiskBlockIndex diskindex;
+        ss >> diskindex;
+        BOOST_CHECK(diskindex.RandomXHeader == index.RandomXHeader);
+        BOOST_CHECK_EQUAL(diskindex.GetBlockHeader().RandomXData, header.RandomXData);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,41 @@
+// Copyright (c) 2020 The DAC Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "spork.h"
+#include "test/test_coin.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(spork_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(spork_snapshot)
+{
+    CSporkManager manager;
+
+    // Without spork messages the defaults are used
+    BOOST_CHECK_EQUAL(manager.GetSporkValue(SPORK_5_INSTANTSEND_MAX_VALUE), mapSporkDefaults[SPORK_5_INSTANTSEND_MAX_VALUE]);
+    BOOST_CHECK_EQUAL(manager.GetSporkValue(SPORK_END + 1), -1);
+    BOOST_CHECK(!manager.IsSporkActive(SPORK_END + 1));
+
+    // String sporks are case-insensitive and a zero value means the default
+    CSporkSnapshotPtr before = manager.GetSnapshot();
+    manager.SetStringSpork("PREVENTSANCTUARYSCALPING", "1", 1);
+    manager.SetStringSpork("MINIMUMUNSIGNEDPRAYERDONATIONAMOUNT", "0", 0);
+    CSporkSnapshotPtr after = manager.GetSnapshot();
+    BOOST_CHECK_EQUAL(after->GetString("preventsanctuaryscalping"), "1");
+    BOOST_CHECK_EQUAL(after->GetDouble("PreventSanctuaryScalping", 0), 1);
+    BOOST_CHECK_EQUAL(after->GetDouble("minimumunsignedprayerdonationamount", 3000), 3000);
+    BOOST_CHECK_EQUAL(after->GetDouble("checkpoolsigs", 5), 5);
+    BOOST_CHECK_EQUAL(after->GetString("checkpoolsigs"), "");
+
+    // Snapshots already handed out never change
+    BOOST_CHECK(before != after);
+    BOOST_CHECK_EQUAL(before->GetString("preventsanctuaryscalping"), "");
+
+    manager.ClearStringSporks();
+    BOOST_CHECK_EQUAL(manager.GetSnapshot()->GetString("preventsanctuaryscalping"), "");
+    BOOST_CHECK_EQUAL(after->GetString("preventsanctuaryscalping"), "1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
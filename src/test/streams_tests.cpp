@@ -72,6 +72,36 @@ BOOST_AUTO_TEST_CASE(streams_vector_writer)
     vch.clear();
 }
 
+BOOST_AUTO_TEST_CASE(streams_span_reader)
+{
+    std::vector<unsigned char> vch = {1, 255, 3, 4, 5, 6};
+
+    CSpanReader reader(SER_NETWORK, INIT_PROTO_VERSION, vch.data(), vch.data() + vch.size());
+    BOOST_CHECK_EQUAL(reader.size(), 6);
+    BOOST_CHECK(!reader.empty());
+
+    unsigned char a;
+    unsigned char b;
+    reader >> a >> b;
+    BOOST_CHECK_EQUAL(a, 1);
+    BOOST_CHECK_EQUAL(b, 255);
+    BOOST_CHECK_EQUAL(reader.size(), 4);
+
+    uint32_t n;
+    reader >> n;
+    BOOST_CHECK_EQUAL(n, 0x06050403);
+    BOOST_CHECK(reader.empty());
+
+    // Reading past the end throws and does not consume anything
+    BOOST_CHECK_THROW(reader >> a, std::ios_base::failure);
+
+    CSpanReader reader2(SER_NETWORK, INIT_PROTO_VERSION, vch.data(), vch.data() + vch.size());
+    reader2.ignore(5);
+    reader2 >> a;
+    BOOST_CHECK_EQUAL(a, 6);
+    BOOST_CHECK_THROW(reader2.ignore(1), std::ios_base::failure);
+}
+
 BOOST_AUTO_TEST_CASE(streams_serializedata_xor)
 {
     std::vector<char> in;
@@ -9,6 +9,8 @@
 #include "chainparams.h"
 #include "consensus/consensus.h"
 #include "consensus/validation.h"
+#include "crypto/sha256.h"
+#include "crypto/x11.h"
 #include "key.h"
 #include "validation.h"
 #include "miner.h"
@@ -20,6 +22,7 @@
 #include "ui_interface.h"
 #include "rpc/server.h"
 #include "rpc/register.h"
+#include "messagesigcache.h"
 #include "script/sigcache.h"
 #include "stacktraces.h"
 
@@ -45,11 +48,14 @@ extern void noui_connect();
 
 BasicTestingSetup::BasicTestingSetup(const std::string& chainName)
 {
+        SHA256AutoDetect();
+        X11AutoDetect();
         ECC_Start();
         BLSInit();
         SetupEnvironment();
         SetupNetworking();
         InitSignatureCache();
+        InitMessageSignatureCache();
         fPrintToDebugLog = false; // don't want to write to debug.log file
         fCheckBlockIndex = true;
         SelectParams(chainName);
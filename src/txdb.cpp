@@ -384,7 +384,7 @@ bool CBlockTreeDB::LoadBlockIndexGuts(boost::function<CBlockIndex*(const uint256
                 pindexNew->nStatus        = diskindex.nStatus;
                 pindexNew->nTx            = diskindex.nTx;
 				pindexNew->RandomXKey     = diskindex.RandomXKey;
-				pindexNew->RandomXData    = diskindex.RandomXData;
+				pindexNew->RandomXHeader  = diskindex.RandomXHeader;
 
 				if (pindexNew->pprev && (diskindex.nHeight > nCheckpointHeight || diskindex.nHeight % 10 == 0))
 				{
@@ -392,7 +392,7 @@ bool CBlockTreeDB::LoadBlockIndexGuts(boost::function<CBlockIndex*(const uint256
 						pindexNew->nTime,
 						pindexNew->pprev->nTime,
 						pindexNew->pprev->nHeight, pindexNew->nNonce, 
-						pindexNew->pprev, pindexNew->RandomXData, pindexNew->RandomXKey, 0, true))
+						pindexNew->pprev, pindexNew->RandomXHeader, pindexNew->RandomXKey, 0, true))
 						return error("LoadBlockIndex(): CheckProofOfWork failed: %s", pindexNew->ToString());
 				}
                 pcursor->Next();
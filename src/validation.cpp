@@ -8,10 +8,13 @@
 
 #include "alert.h"
 #include "arith_uint256.h"
+#include "blockcache.h"
 #include "blockencodings.h"
+#include "blockfilemap.h"
 #include "chainparams.h"
 #include "checkpoints.h"
 #include "checkqueue.h"
+#include "ctpl.h"
 #include "consensus/consensus.h"
 #include "consensus/merkle.h"
 #include "consensus/validation.h"
@@ -53,6 +56,8 @@
 #include "llmq/quorums_chainlocks.h"
 
 #include <atomic>
+#include <future>
+#include <mutex>
 #include <sstream>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -115,6 +120,7 @@ CTxMemPool mempool;
 std::map<uint256, int64_t> mapRejectedBlocks GUARDED_BY(cs_main);
 
 // DAC
+CCriticalSection csApplicationCache;
 std::map<std::pair<std::string, std::string>, std::pair<std::string, int64_t>> mvApplicationCache;
 std::map<std::string, POSEScore> mvPOSEScore;
 std::map<std::string, Researcher> mvResearchers;
@@ -1199,17 +1205,41 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus:
 {
     block.SetNull();
 
-    // Open history file to read
-    CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
-    if (filein.IsNull())
-        return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
-
-    // Read block
-    try {
-        filein >> block;
+    // Deserialize straight from a memory mapping of the block file when possible. The record
+    // is preceded by the message start and its size, see WriteBlockToDisk.
+    bool fRead = false;
+    std::shared_ptr<const CMappedBlockFile> pmap;
+    if (pos.nPos >= 4)
+        pmap = blockFileMapCache.Get(pos.nFile, GetBlockPosFilename(pos, "blk"), pos.nPos);
+    if (pmap && pos.nPos <= pmap->size()) {
+        uint64_t nEnd = (uint64_t)pos.nPos + ReadLE32(pmap->data() + pos.nPos - 4);
+        if (nEnd > pmap->size())
+            pmap = blockFileMapCache.Get(pos.nFile, GetBlockPosFilename(pos, "blk"), nEnd);
+        if (pmap && nEnd <= pmap->size()) {
+            try {
+                CSpanReader reader(SER_DISK, CLIENT_VERSION, pmap->data() + pos.nPos, pmap->data() + nEnd);
+                reader >> block;
+                fRead = true;
+            } catch (const std::exception&) {
+                // Fall back to reading the file, which reports the error if there really is one
+                block.SetNull();
+            }
+        }
     }
-    catch (const std::exception& e) {
-        return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+
+    if (!fRead) {
+        // Open history file to read
+        CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
+        if (filein.IsNull())
+            return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
+
+        // Read block
+        try {
+            filein >> block;
+        }
+        catch (const std::exception& e) {
+            return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+        }
     }
 
     // Check the header
@@ -1221,7 +1251,7 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus:
 		CBlockIndex* pindexPrev = mapBlockIndex[block.hashPrevBlock];
 		if (pindexPrev)
 		{
-			if (!CheckProofOfWork(block.GetHash(), block.nBits, consensusParams, block.GetBlockTime(), pindexPrev->nTime, pindexPrev->nHeight, block.nNonce, pindexPrev, block.RandomXData, block.RandomXKey, 0, true))
+			if (!CheckProofOfWork(block.GetHash(), block.nBits, consensusParams, block.GetBlockTime(), pindexPrev->nTime, pindexPrev->nHeight, block.nNonce, pindexPrev, block.GetRandomXHeader(), block.RandomXKey, 0, true))
 				return error("ReadBlockFromDisk: Errors in block header at %s", pos.ToString());
 		}
 	}
@@ -1231,11 +1261,18 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus:
 
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams, bool fPOW)
 {
+    // Copying a cached block only copies the transaction references
+    std::shared_ptr<const CBlock> pcached = recentBlockCache.Get(pindex->GetBlockHash(), fPOW);
+    if (pcached) {
+        block = *pcached;
+        return true;
+    }
     if (!ReadBlockFromDisk(block, pindex->GetBlockPos(), consensusParams, fPOW))
         return false;
     if (block.GetHash() != pindex->GetBlockHash())
         return error("ReadBlockFromDisk(CBlock&, CBlockIndex*): GetHash() doesn't match index for %s at %s",
                 pindex->ToString(), pindex->GetBlockPos().ToString());
+    recentBlockCache.Insert(pindex->GetBlockHash(), std::make_shared<const CBlock>(block), fPOW);
     return true;
 }
 
@@ -1526,6 +1563,11 @@ bool CScriptCheck::operator()() {
     return true;
 }
 
+bool CTxMessageSignatureCheck::operator()() {
+    *pfSigned = CheckTxMessageSignature(tx, sType);
+    return true;
+}
+
 int GetSpendHeight(const CCoinsViewCache& inputs)
 {
     LOCK(cs_main);
@@ -1948,8 +1990,10 @@ void static FlushBlockFile(bool fFinalize = false)
 
     FILE *fileOld = OpenBlockFile(posOld);
     if (fileOld) {
-        if (fFinalize)
+        if (fFinalize) {
+            blockFileMapCache.Release(nLastBlockFile);
             TruncateFile(fileOld, vinfoBlockFile[nLastBlockFile].nSize);
+        }
         FileCommit(fileOld);
         fclose(fileOld);
     }
@@ -1972,6 +2016,49 @@ void ThreadScriptCheck() {
     scriptcheckqueue.Thread();
 }
 
+static CCheckQueue<CTxMessageSignatureCheck> txmessagecheckqueue(128);
+// Only the GSC and ABN scans (RPC, GSC reports) use these, most nodes never start them
+static boost::thread_group txMessageCheckThreads;
+static std::once_flag txMessageCheckThreadsOnce;
+
+static void ThreadTxMessageCheck() {
+    RenameThread("dac-txmsgch");
+    txmessagecheckqueue.Thread();
+}
+
+void StopTxMessageCheckThreads()
+{
+    txMessageCheckThreads.interrupt_all();
+    txMessageCheckThreads.join_all();
+}
+
+void CheckTxMessageSignatures(const CBlock& block, std::vector<char>& vGSCSigned, std::vector<char>* pvABNSigned)
+{
+    vGSCSigned.assign(block.vtx.size(), 0);
+    if (pvABNSigned)
+        pvABNSigned->assign(block.vtx.size(), 0);
+    std::vector<CTxMessageSignatureCheck> vChecks;
+    for (unsigned int n = 0; n < block.vtx.size(); n++) {
+        if (block.vtx[n]->IsGSCTransmission())
+            vChecks.push_back(CTxMessageSignatureCheck(block.vtx[n], "gsc", &vGSCSigned[n]));
+        if (pvABNSigned && block.vtx[n]->IsABN())
+            vChecks.push_back(CTxMessageSignatureCheck(block.vtx[n], "abn", &(*pvABNSigned)[n]));
+    }
+    // Without worker threads the control would drop the checks, so run them here
+    if (nScriptCheckThreads == 0 || vChecks.size() < 2) {
+        for (auto& check : vChecks)
+            check();
+        return;
+    }
+    std::call_once(txMessageCheckThreadsOnce, []() {
+        for (int i = 0; i < nScriptCheckThreads - 1; i++)
+            txMessageCheckThreads.create_thread(&ThreadTxMessageCheck);
+    });
+    CCheckQueueControl<CTxMessageSignatureCheck> control(&txmessagecheckqueue);
+    control.Add(vChecks);
+    control.Wait();
+}
+
 // Protected by cs_main
 VersionBitsCache versionbitscache;
 
@@ -2061,18 +2148,19 @@ static int64_t nTimeTotal = 0;
  *  Validity checks that depend on the UTXO set are also done; ConnectBlock()
  *  can fail if those validity checks fail (among other reasons). */
 static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex,
-                  CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck = false)
+                  CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck = false, const uint256* pBlockHash = NULL)
 {
     AssertLockHeld(cs_main);
 	assert(pindex);	
-    // pindex->phashBlock can be null if called by CreateNewBlock/TestBlockValidity	
-    assert((pindex->phashBlock == NULL) ||	
-           (*pindex->phashBlock == block.GetHash()));
+    // pindex->phashBlock can be null if called by CreateNewBlock/TestBlockValidity, which pass the
+    // hash they already computed instead. Blocks connected to the index were matched against it when
+    // they were accepted (AcceptBlock) or read back (ReadBlockFromDisk)
+    const uint256 hashBlock = pindex->phashBlock ? *pindex->phashBlock : pBlockHash ? *pBlockHash : block.GetHash();
 
     int64_t nTimeStart = GetTimeMicros();
 
     // Check it again in case a previous version let a bad block in
-    if (!CheckBlock(block, state, chainparams.GetConsensus(), !fJustCheck, !fJustCheck))
+    if (!CheckBlock(block, state, chainparams.GetConsensus(), !fJustCheck, !fJustCheck, 0, 0, 0, NULL, &hashBlock))
         return error("%s: Consensus::CheckBlock: %s", __func__, FormatStateMessage(state));
 
 	if (pindex->pprev && pindex->phashBlock && llmq::chainLocksHandler->HasConflictingChainLock(pindex->nHeight, pindex->GetBlockHash())) {	
@@ -2095,7 +2183,7 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
 
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
-    if (block.GetHash() == chainparams.GetConsensus().hashGenesisBlock) {
+    if (hashBlock == chainparams.GetConsensus().hashGenesisBlock) {
         if (!fJustCheck)
             view.SetBestBlock(pindex->GetBlockHash());
         return true;
@@ -2173,7 +2261,7 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
     // make sure old budget is the real one
     if (pindex->nHeight == chainparams.GetConsensus().nSuperblockStartBlock &&
         chainparams.GetConsensus().nSuperblockStartHash != uint256() &&
-        block.GetHash() != chainparams.GetConsensus().nSuperblockStartHash)
+        hashBlock != chainparams.GetConsensus().nSuperblockStartHash)
             return state.DoS(100, error("ConnectBlock(): invalid superblock start"),
                              REJECT_INVALID, "bad-sb-start");
 
@@ -2394,7 +2482,7 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
                     // The node which relayed this should switch to correct chain.	
                     // TODO: relay instantsend data/proof.	
                     LOCK(cs_main);	
-                    mapRejectedBlocks.insert(std::make_pair(block.GetHash(), GetTime()));	
+                    mapRejectedBlocks.insert(std::make_pair(hashBlock, GetTime()));	
 			        return state.DoS(10, error("ConnectBlock::ERROR Transaction %s conflicts with transaction lock %s", tx->GetHash().ToString(), hashLocked.ToString()),	
                                      REJECT_INVALID, "conflict-tx-lock");	
                 }	
@@ -2410,7 +2498,7 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
                 // The node which relayed this should switch to correct chain.	
                 // TODO: relay instantsend data/proof.	
                 LOCK(cs_main);	
-                mapRejectedBlocks.insert(std::make_pair(block.GetHash(), GetTime()));	
+                mapRejectedBlocks.insert(std::make_pair(hashBlock, GetTime()));	
                 return state.DoS(10, error("ConnectBlock(DASH): transaction %s conflicts with transaction lock %s", tx->GetHash().ToString(), conflictLock->txid.ToString()),	
                                  REJECT_INVALID, "conflict-tx-lock");	
             }	
@@ -2433,7 +2521,7 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
 	if (GetSporkDouble("SPORK_8_MASTERNODE_PAYMENT_ENFORCEMENT", 0) == 1) 
 	{
 		if (!IsBlockPayeeValid(*block.vtx[0], pindex->nHeight, blockReward)) {
-			mapRejectedBlocks.insert(std::make_pair(block.GetHash(), GetTime()));
+			mapRejectedBlocks.insert(std::make_pair(hashBlock, GetTime()));
 			return state.DoS(0, error("ConnectBlock::ERROR::Couldn't find masternode or superblock payments"),
 									REJECT_INVALID, "bad-cb-payee");
 		}
@@ -2806,6 +2894,7 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
                 InvalidBlockFound(pindexNew, state);
             return error("ConnectTip(): ConnectBlock %s failed with %s", pindexNew->GetBlockHash().ToString(), FormatStateMessage(state));
         }
+        recentBlockCache.Insert(pindexNew->GetBlockHash(), connectTrace.blocksConnected.back().second, true);
         nTime3 = GetTimeMicros(); nTimeConnectTotal += nTime3 - nTime2;
         if (fDebugSpam)
 			LogPrint("bench", "  - Connect total: %.2fms [%.2fs]\n", (nTime3 - nTime2) * 0.001, nTimeConnectTotal * 0.000001);
@@ -3061,7 +3150,7 @@ static void NotifyHeaderTip() {
  * or an activated best chain. pblock is either NULL or a pointer to a block
  * that is already loaded (to avoid loading it again from disk).
  */
-bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams, std::shared_ptr<const CBlock> pblock) {
+bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams, std::shared_ptr<const CBlock> pblock, const uint256* pBlockHash) {
     // Note that while we're often called here from ProcessNewBlock, this is
     // far from a guarantee. Things in the P2P/RPC will often end up calling
     // us in the middle of ProcessNewBlock - do not assume pblock is set
@@ -3073,6 +3162,7 @@ bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams,
     static CCriticalSection cs_activateBestChain;	
     LOCK(cs_activateBestChain);
 
+    const uint256 hashBlock = pBlockHash ? *pBlockHash : pblock ? pblock->GetHash() : uint256();
     CBlockIndex *pindexMostWork = NULL;
     CBlockIndex *pindexNewTip = NULL;
     do {
@@ -3104,7 +3194,7 @@ bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams,
 
             bool fInvalidFound = false;
             std::shared_ptr<const CBlock> nullBlockPtr;
-            if (!ActivateBestChainStep(state, chainparams, pindexMostWork, pblock && pblock->GetHash() == pindexMostWork->GetBlockHash() ? pblock : nullBlockPtr, fInvalidFound, connectTrace))
+            if (!ActivateBestChainStep(state, chainparams, pindexMostWork, pblock && hashBlock == pindexMostWork->GetBlockHash() ? pblock : nullBlockPtr, fInvalidFound, connectTrace))
                 return false;
 
             if (fInvalidFound) {
@@ -3269,10 +3359,9 @@ bool ResetBlockFailureFlags(CBlockIndex *pindex) {
     return true;
 }
 
-CBlockIndex* AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus = BLOCK_VALID_TREE)
+CBlockIndex* AddToBlockIndex(const CBlockHeader& block, const uint256& hash, enum BlockStatus nStatus = BLOCK_VALID_TREE)
 {
     // Check for duplicate
-    uint256 hash = block.GetHash();
     BlockMap::iterator it = mapBlockIndex.find(hash);
     if (it != mapBlockIndex.end())
         return it->second;
@@ -3450,7 +3539,7 @@ bool FindUndoPos(CValidationState &state, int nFile, CDiskBlockPos &pos, unsigne
     return true;
 }
 
-bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, int64_t nBlockTime, int64_t nPrevBlockTime, int nPrevHeight, const CBlockIndex* pindexPrev)
+bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, int64_t nBlockTime, int64_t nPrevBlockTime, int nPrevHeight, const CBlockIndex* pindexPrev, const uint256* pBlockHash)
 {
     // Check proof of work matches claimed amount
 	// R ANDREWS - DAC needs these 6 additional fields
@@ -3459,7 +3548,7 @@ bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const
 		LogPrintf("\nChecking blockheader %f with rxhash %s and rxmsg %s ", nPrevHeight, block.RandomXKey.GetHex(), block.RandomXData);
 	}
 	
-	if (fCheckPOW && !CheckProofOfWork(block.GetHash(), block.nBits, Params().GetConsensus(), nBlockTime, nPrevBlockTime, nPrevHeight, block.nNonce, pindexPrev, block.RandomXData, block.RandomXKey, 0, false))
+	if (fCheckPOW && !CheckProofOfWork(pBlockHash ? *pBlockHash : block.GetHash(), block.nBits, Params().GetConsensus(), nBlockTime, nPrevBlockTime, nPrevHeight, block.nNonce, pindexPrev, block.GetRandomXHeader(), block.RandomXKey, 0, false))
 	{
 		LogPrintf("\nCheckBlockHeader::ERROR-FAILED height %f, nonce %f", nPrevHeight, block.nNonce);
         return state.DoS(5, false, REJECT_INVALID, "high-hash", false, "proof of work failed");
@@ -3473,7 +3562,7 @@ bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const
 	// Check DevNet
     if (!consensusParams.hashDevnetGenesisBlock.IsNull() &&
             block.hashPrevBlock == consensusParams.hashGenesisBlock &&
-            block.GetHash() != consensusParams.hashDevnetGenesisBlock) {
+            (pBlockHash ? *pBlockHash : block.GetHash()) != consensusParams.hashDevnetGenesisBlock) {
         return state.DoS(100, error("CheckBlockHeader(): wrong devnet genesis"),
                          REJECT_INVALID, "devnet-genesis");
     }
@@ -3481,7 +3570,7 @@ bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const
     return true;
 }
 	
-bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot, int64_t nBlockTime, int64_t nPrevBlockTime, int nPrevHeight, CBlockIndex* pindexPrev)
+bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot, int64_t nBlockTime, int64_t nPrevBlockTime, int nPrevHeight, CBlockIndex* pindexPrev, const uint256* pBlockHash)
 {
     // These are checks that are independent of context.
 
@@ -3491,7 +3580,7 @@ bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::P
     // Check that the header is valid (particularly PoW).  This is mostly
     // redundant with the call in AcceptBlockHeader.
 	
-    if (!CheckBlockHeader(block, state, consensusParams, fCheckPOW, nBlockTime, nPrevBlockTime, nPrevHeight, pindexPrev))
+    if (!CheckBlockHeader(block, state, consensusParams, fCheckPOW, nBlockTime, nPrevBlockTime, nPrevHeight, pindexPrev, pBlockHash))
         return false;
 
     // Check the merkle root.
@@ -3807,11 +3896,10 @@ bool ContextualCheckBlock(const CBlock& block, CValidationState& state, const Co
     return true;
 }
 
-static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex)
+static bool AcceptBlockHeader(const CBlockHeader& block, const uint256& hash, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex)
 {
     AssertLockHeld(cs_main);
     // Check for duplicate
-    uint256 hash = block.GetHash();
     BlockMap::iterator miSelf = mapBlockIndex.find(hash);
     CBlockIndex *pindex = NULL;
 
@@ -3838,7 +3926,7 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
 
 		pindexPrev = (*mi).second;
 		// R ANDREWS - Now we can check the block header:
-		if (!CheckBlockHeader(block, state, chainparams.GetConsensus(), true, block.GetBlockTime(), pindexPrev ? pindexPrev->nTime : 0, pindexPrev ? pindexPrev->nHeight : 0, pindexPrev))
+		if (!CheckBlockHeader(block, state, chainparams.GetConsensus(), true, block.GetBlockTime(), pindexPrev ? pindexPrev->nTime : 0, pindexPrev ? pindexPrev->nHeight : 0, pindexPrev, &hash))
             return error("%s: Consensus::CheckBlockHeader: %s, %s", __func__, hash.ToString(), FormatStateMessage(state));
 
 		if (pindexPrev->nStatus & BLOCK_FAILED_MASK)
@@ -3859,13 +3947,13 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
 
 		 if (llmq::chainLocksHandler->HasConflictingChainLock(pindexPrev->nHeight + 1, hash)) {	
             if (pindex == NULL) {	
-                AddToBlockIndex(block, BLOCK_CONFLICT_CHAINLOCK);	
+                AddToBlockIndex(block, hash, BLOCK_CONFLICT_CHAINLOCK);	
             }	
             return state.DoS(10, error("%s: header %s conflicts with chainlock", __func__, hash.ToString()), REJECT_INVALID, "bad-chainlock");	
         }
     }
     if (pindex == NULL)
-        pindex = AddToBlockIndex(block);
+        pindex = AddToBlockIndex(block, hash);
 
     if (ppindex)
         *ppindex = pindex;
@@ -3879,13 +3967,19 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
 }
 
 // Exposed wrapper for AcceptBlockHeader
-bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex)
+bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, const std::vector<uint256>* pvHashes)
 {
+    std::vector<uint256> vHashes;
+    if (!pvHashes) {
+        vHashes = GetBlockHeaderHashes(headers);
+        pvHashes = &vHashes;
+    }
+    assert(pvHashes->size() == headers.size());
     {
         LOCK(cs_main);
-        for (const CBlockHeader& header : headers) {
+        for (size_t i = 0; i < headers.size(); i++) {
             CBlockIndex *pindex = NULL; // Use a temp pindex instead of ppindex to avoid a const_cast
-            if (!AcceptBlockHeader(header, state, chainparams, &pindex)) {
+            if (!AcceptBlockHeader(headers[i], (*pvHashes)[i], state, chainparams, &pindex)) {
                 return false;
             }
             if (ppindex) {
@@ -3898,7 +3992,7 @@ bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, CValidatio
 }
 
 /** Store block on disk. If dbp is non-NULL, the file is known to already reside on disk */
-static bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, const CDiskBlockPos* dbp, bool* fNewBlock)
+static bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, const uint256& hash, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, const CDiskBlockPos* dbp, bool* fNewBlock)
 {
     const CBlock& block = *pblock;
 
@@ -3908,7 +4002,7 @@ static bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidation
     CBlockIndex *pindexDummy = NULL;
     CBlockIndex *&pindex = ppindex ? *ppindex : pindexDummy;
 
-    if (!AcceptBlockHeader(block, state, chainparams, &pindex))
+    if (!AcceptBlockHeader(block, hash, state, chainparams, &pindex))
         return false;
 
     // Try to process all requested blocks that we don't have, but only
@@ -3938,7 +4032,7 @@ static bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidation
     }
     if (fNewBlock) *fNewBlock = true;
 	// DAC needs to pass in these 4 additional fields into CheckBlock:
-    if  (!CheckBlock(block, state, chainparams.GetConsensus(), true, true, block.GetBlockTime(), pindex->pprev ? pindex->pprev->nTime : 0, pindex->pprev ? pindex->pprev->nHeight : 0, pindex->pprev) || 
+    if  (!CheckBlock(block, state, chainparams.GetConsensus(), true, true, block.GetBlockTime(), pindex->pprev ? pindex->pprev->nTime : 0, pindex->pprev ? pindex->pprev->nHeight : 0, pindex->pprev, &hash) || 
 		 !ContextualCheckBlock(block, state, chainparams.GetConsensus(), pindex->pprev, false)) {
 		if (state.IsInvalid() && !state.CorruptionPossible()) {
 			pindex->nStatus |= BLOCK_FAILED_VALID;
@@ -3980,19 +4074,21 @@ static bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidation
 bool ProcessNewBlock(const CChainParams& chainparams, const std::shared_ptr<const CBlock> pblock, bool fForceProcessing, bool *fNewBlock)
 {
 	AssertLockNotHeld(cs_main);
+    // Hashed once here, the checks below and connecting the block reuse it
+    const uint256 hash = pblock->GetHash();
     {
         CBlockIndex *pindex = NULL;
         if (fNewBlock) *fNewBlock = false;
         CValidationState state;
         // Ensure that CheckBlock() passes before calling AcceptBlock, as
         // belt-and-suspenders.
-        bool ret = CheckBlock(*pblock, state, chainparams.GetConsensus());
+        bool ret = CheckBlock(*pblock, state, chainparams.GetConsensus(), true, true, 0, 0, 0, NULL, &hash);
 
         LOCK(cs_main);
 
         if (ret) {
             // Store to disk
-            ret = AcceptBlock(pblock, state, chainparams, &pindex, fForceProcessing, NULL, fNewBlock);
+            ret = AcceptBlock(pblock, hash, state, chainparams, &pindex, fForceProcessing, NULL, fNewBlock);
         }
         CheckBlockIndex(chainparams.GetConsensus());
         if (!ret) {
@@ -4004,7 +4100,7 @@ bool ProcessNewBlock(const CChainParams& chainparams, const std::shared_ptr<cons
     NotifyHeaderTip();
 
     CValidationState state; // Only used to report errors, not invalidity - ignore it
-    if (!ActivateBestChain(state, chainparams, pblock))
+    if (!ActivateBestChain(state, chainparams, pblock, &hash))
         return error("%s: ActivateBestChain failed: %s", __func__, FormatStateMessage(state));
 	LogPrintf("{PNB}: %s ", "ACC ");
 	return true;
@@ -4079,11 +4175,11 @@ bool TestBlockValidity(CValidationState& state, const CChainParams& chainparams,
 	// NOTE: CheckBlockHeader is called by CheckBlock
 	if (!ContextualCheckBlockHeader(block, state, chainparams.GetConsensus(), pindexPrev, GetAdjustedTime()))
 		return error("%s: Consensus::ContextualCheckBlockHeader: %s", __func__, FormatStateMessage(state));
-	if (!CheckBlock(block, state, chainparams.GetConsensus(), fCheckPOW, fCheckMerkleRoot))
+	if (!CheckBlock(block, state, chainparams.GetConsensus(), fCheckPOW, fCheckMerkleRoot, 0, 0, 0, NULL, &hash))
 		return error("%s: Consensus::CheckBlock: %s", __func__, FormatStateMessage(state));
 	if (!ContextualCheckBlock(block, state, chainparams.GetConsensus(), pindexPrev, fMining))
 		return error("%s: Consensus::ContextualCheckBlock: %s", __func__, FormatStateMessage(state));
-	if (!ConnectBlock(block, state, &indexDummy, viewNew, chainparams, true))
+	if (!ConnectBlock(block, state, &indexDummy, viewNew, chainparams, true, &hash))
 		return false;
 	assert(state.IsValid());
 
@@ -4142,6 +4238,7 @@ void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune)
 {
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
         CDiskBlockPos pos(*it, 0);
+        blockFileMapCache.Release(*it);
         boost::filesystem::remove(GetBlockPosFilename(pos, "blk"));
         boost::filesystem::remove(GetBlockPosFilename(pos, "rev"));
         LogPrintf("Prune: %s deleted blk/rev (%05u)\n", __func__, *it);
@@ -4572,7 +4669,7 @@ static bool AddGenesisBlock(const CChainParams& chainparams, const CBlock& block
         return error("%s: FindBlockPos failed", __func__);
     if (!WriteBlockToDisk(block, blockPos, chainparams.MessageStart()))
         return error("%s: writing genesis block to disk failed", __func__);
-    CBlockIndex *pindex = AddToBlockIndex(block);
+    CBlockIndex *pindex = AddToBlockIndex(block, block.GetHash());
     if (!ReceivedBlockTransactions(block, state, pindex, blockPos))
         return error("%s: genesis block not accepted", __func__);
     return true;
@@ -4615,9 +4712,10 @@ bool InitBlockIndex(const CChainParams& chainparams)
                 // We can't continue if devnet genesis block is invalid
                 std::shared_ptr<const CBlock> shared_pblock = std::make_shared<const CBlock>(chainparams.DevNetGenesisBlock());
 
-				bool fCheckBlock = CheckBlock(*shared_pblock, state, chainparams.GetConsensus());	         
+				const uint256 hash = shared_pblock->GetHash();
+				bool fCheckBlock = CheckBlock(*shared_pblock, state, chainparams.GetConsensus(), true, true, 0, 0, 0, NULL, &hash);	         
                 assert(fCheckBlock);	              
-                if (!AcceptBlock(shared_pblock, state, chainparams, NULL, true, NULL, NULL))	
+                if (!AcceptBlock(shared_pblock, hash, state, chainparams, NULL, true, NULL, NULL))	
                     return false;
 
             }
@@ -4632,19 +4730,141 @@ bool InitBlockIndex(const CChainParams& chainparams)
     return true;
 }
 
+namespace {
+/** A block read from a block file, deserialized and pre-checked by an import worker */
+struct CImportedBlock
+{
+    std::shared_ptr<CBlock> pblock;
+    uint256 hash;
+    CDiskBlockPos pos;
+};
+
+CImportedBlock PrepareImportedBlock(int iWorker, std::shared_ptr<CDataStream> pssBlock, const CDiskBlockPos& pos)
+{
+    CImportedBlock imported;
+    imported.pos = pos;
+    imported.pblock = std::make_shared<CBlock>();
+    *pssBlock >> *imported.pblock;
+    const CBlock& block = *imported.pblock;
+    imported.hash = block.GetHash();
+    // Warm the RandomX proof-of-work cache so the ordered stage only does a lookup
+    if (block.nVersion >= 0x50000000UL && block.nVersion < 0x60000000UL)
+        GetCachedRandomXHash(block.GetRandomXHeader().GetBytes(), block.RandomXKey, block.hashPrevBlock, IMPORT_RANDOMX_THREAD_ID + iWorker);
+    return imported;
+}
+
+/** Stops an import worker pool without running queued jobs when the import is interrupted or aborted */
+struct CImportPoolGuard
+{
+    ctpl::thread_pool& pool;
+    explicit CImportPoolGuard(ctpl::thread_pool& _pool) : pool(_pool) {}
+    ~CImportPoolGuard() { pool.stop(false); }
+};
+} // namespace
+
 bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskBlockPos *dbp)
 {
     // Map of disk positions for blocks with unknown parent (only used for reindex)
     static std::multimap<uint256, CDiskBlockPos> mapBlocksUnknownParent;
     int64_t nStart = GetTimeMillis();
 
+    // The import is a pipeline: this thread scans the file for blocks, a worker pool deserializes
+    // them and does the expensive hashing, and the results are accepted here in file order.
+    int nThreads = GetArg("-reindexthreads", DEFAULT_REINDEX_THREADS);
+    if (nThreads <= 0)
+        nThreads = std::min(GetNumCores(), MAX_REINDEX_THREADS / 4);
+    nThreads = std::max(1, std::min(nThreads, MAX_REINDEX_THREADS));
+    const size_t nMaxInFlight = nThreads * 8;
+    ctpl::thread_pool workerPool(nThreads);
+    RenameThreadPool(workerPool, "biblepay-loadblk");
+    CImportPoolGuard poolGuard(workerPool);
+    std::deque<std::future<CImportedBlock> > queueInFlight;
+
     int nLoaded = 0;
+    bool fAbort = false;
+
+    // Ordered stage: accept one prepared block and any earlier seen descendants
+    auto acceptImported = [&](std::future<CImportedBlock>& future) {
+        try {
+            CImportedBlock imported = future.get();
+            std::shared_ptr<CBlock> pblock = imported.pblock;
+            const CBlock& block = *pblock;
+            const uint256& hash = imported.hash;
+            CDiskBlockPos* dbpBlock = dbp ? &imported.pos : NULL;
+
+            // detect out of order blocks, and store them for later
+            if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(block.hashPrevBlock) == mapBlockIndex.end()) {
+                LogPrint("reindex", "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
+                        block.hashPrevBlock.ToString());
+                if (dbpBlock)
+                    mapBlocksUnknownParent.insert(std::make_pair(block.hashPrevBlock, *dbpBlock));
+                return;
+            }
+
+            // process in case the block isn't known yet
+            if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
+                LOCK(cs_main);
+                CValidationState state;
+                if (AcceptBlock(pblock, hash, state, chainparams, NULL, true, dbpBlock, NULL))
+                    nLoaded++;
+                if (state.IsError()) {
+                    fAbort = true;
+                    return;
+                }
+            } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
+                LogPrint("reindex", "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
+            }
+
+            // Activate the genesis block so normal node progress can continue
+            if (hash == chainparams.GetConsensus().hashGenesisBlock) {
+                CValidationState state;
+                if (!ActivateBestChain(state, chainparams)) {
+                    fAbort = true;
+                    return;
+                }
+            }
+
+            NotifyHeaderTip();
+
+            // Recursively process earlier encountered successors of this block
+            std::deque<uint256> queue;
+            queue.push_back(hash);
+            while (!queue.empty()) {
+                uint256 head = queue.front();
+                queue.pop_front();
+                std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
+                while (range.first != range.second) {
+                    std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
+                    std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
+                    if (ReadBlockFromDisk(*pblockrecursive, it->second, chainparams.GetConsensus()))
+                    {
+                        const uint256 hashRecursive = pblockrecursive->GetHash();
+                        LogPrint("reindex", "%s: Processing out of order child %s of %s\n", __func__, hashRecursive.ToString(),
+                                head.ToString());
+                        LOCK(cs_main);
+                        CValidationState dummy;
+                        if (AcceptBlock(pblockrecursive, hashRecursive, dummy, chainparams, NULL, true, &it->second, NULL))
+                        {
+                            nLoaded++;
+                            queue.push_back(hashRecursive);
+                        }
+                    }
+                    range.first++;
+                    mapBlocksUnknownParent.erase(it);
+                    NotifyHeaderTip();
+                }
+            }
+        } catch (const std::exception& e) {
+            LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
+        }
+    };
+
     try {
         unsigned int nMaxBlockSize = MaxBlockSize(true);
         // This takes over fileIn and calls fclose() on it in the CBufferedFile destructor
         CBufferedFile blkdat(fileIn, 2*nMaxBlockSize, nMaxBlockSize+8, SER_DISK, CLIENT_VERSION);
         uint64_t nRewind = blkdat.GetPos();
-        while (!blkdat.eof()) {
+        while (!blkdat.eof() && !fAbort) {
             boost::this_thread::interruption_point();
 
             blkdat.SetPos(nRewind);
@@ -4668,79 +4888,32 @@ bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskB
                 break;
             }
             try {
-                // read block
+                // read the raw block and hand it to a worker
                 uint64_t nBlockPos = blkdat.GetPos();
-                if (dbp)
-                    dbp->nPos = nBlockPos;
+                CDiskBlockPos pos = dbp ? *dbp : CDiskBlockPos();
+                pos.nPos = nBlockPos;
                 blkdat.SetLimit(nBlockPos + nSize);
                 blkdat.SetPos(nBlockPos);
-                std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
-                CBlock& block = *pblock;
-                blkdat >> block;
+                std::shared_ptr<CDataStream> pssBlock = std::make_shared<CDataStream>(SER_DISK, CLIENT_VERSION);
+                pssBlock->resize(nSize);
+                blkdat.read(&(*pssBlock)[0], nSize);
                 nRewind = blkdat.GetPos();
-
-                // detect out of order blocks, and store them for later
-                uint256 hash = block.GetHash();
-                if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(block.hashPrevBlock) == mapBlockIndex.end()) {
-                    LogPrint("reindex", "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                            block.hashPrevBlock.ToString());
-                    if (dbp)
-                        mapBlocksUnknownParent.insert(std::make_pair(block.hashPrevBlock, *dbp));
-                    continue;
-                }
-
-                // process in case the block isn't known yet
-                if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
-                    LOCK(cs_main);
-                    CValidationState state;
-                    if (AcceptBlock(pblock, state, chainparams, NULL, true, dbp, NULL))
-                        nLoaded++;
-                    if (state.IsError())
-                        break;
-                } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
-                    LogPrint("reindex", "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
-                }
-
-                // Activate the genesis block so normal node progress can continue
-                if (hash == chainparams.GetConsensus().hashGenesisBlock) {
-                    CValidationState state;
-                    if (!ActivateBestChain(state, chainparams)) {
-                        break;
-                    }
-                }
-
-                NotifyHeaderTip();
-
-                // Recursively process earlier encountered successors of this block
-                std::deque<uint256> queue;
-                queue.push_back(hash);
-                while (!queue.empty()) {
-                    uint256 head = queue.front();
-                    queue.pop_front();
-                    std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
-                    while (range.first != range.second) {
-                        std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
-                        std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
-                        if (ReadBlockFromDisk(*pblockrecursive, it->second, chainparams.GetConsensus()))
-                        {
-                            LogPrint("reindex", "%s: Processing out of order child %s of %s\n", __func__, pblockrecursive->GetHash().ToString(),
-                                    head.ToString());
-                            LOCK(cs_main);
-                            CValidationState dummy;
-                            if (AcceptBlock(pblockrecursive, dummy, chainparams, NULL, true, &it->second, NULL))
-                            {
-                                nLoaded++;
-                                queue.push_back(pblockrecursive->GetHash());
-                            }
-                        }
-                        range.first++;
-                        mapBlocksUnknownParent.erase(it);
-                        NotifyHeaderTip();
-                    }
-                }
+                queueInFlight.emplace_back(workerPool.push([pssBlock, pos](int iWorker) {
+                    return PrepareImportedBlock(iWorker, pssBlock, pos);
+                }));
             } catch (const std::exception& e) {
                 LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
             }
+
+            while (queueInFlight.size() >= nMaxInFlight && !fAbort) {
+                acceptImported(queueInFlight.front());
+                queueInFlight.pop_front();
+            }
+        }
+        while (!queueInFlight.empty() && !fAbort) {
+            boost::this_thread::interruption_point();
+            acceptImported(queueInFlight.front());
+            queueInFlight.pop_front();
         }
     } catch (const std::runtime_error& e) {
         AbortNode(std::string("System error: ") + e.what());
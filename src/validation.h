@@ -88,6 +88,12 @@ static const unsigned int UNDOFILE_CHUNK_SIZE = 0x100000; // 1 MiB
 static const int MAX_SCRIPTCHECK_THREADS = 16;
 /** -par default (number of script-checking threads, 0 = auto) */
 static const int DEFAULT_SCRIPTCHECK_THREADS = 0;
+/** Maximum number of block import worker threads used by -reindex and -loadblock */
+static const int MAX_REINDEX_THREADS = 16;
+/** -reindexthreads default (number of block import worker threads, 0 = auto) */
+static const int DEFAULT_REINDEX_THREADS = 0;
+/** RandomX thread IDs used by block import workers start here, clear of miner and RPC thread IDs */
+static const int IMPORT_RANDOMX_THREAD_ID = 200;
 /** Number of blocks that can be requested at any given time from a single peer. */
 static const int MAX_BLOCKS_IN_TRANSIT_PER_PEER = 16;
 /** Timeout in seconds during which a peer must stall block download progress before being disconnected. */
@@ -256,6 +262,8 @@ extern bool fLargeWorkForkFound;
 extern bool fLargeWorkInvalidChainFound;
 
 extern std::map<uint256, int64_t> mapRejectedBlocks;
+/** Guards mvApplicationCache; only modify it through WriteCache and ClearCache so its memory accounting stays right */
+extern CCriticalSection csApplicationCache;
 extern std::map<std::pair<std::string, std::string>, std::pair<std::string, int64_t>> mvApplicationCache;
 
 struct POSEScore;
@@ -327,8 +335,9 @@ bool ProcessNewBlock(const CChainParams& chainparams, const std::shared_ptr<cons
  * @param[out] state This may be set to an Error state if any error occurred processing them
  * @param[in]  chainparams The params for the chain we want to connect to
  * @param[out] ppindex If set, the pointer will be set to point to the last new block index object for the given headers
+ * @param[in]  pvHashes The hashes of the headers, if the caller computed them already (see GetBlockHeaderHashes)
  */
-bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex=NULL);
+bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex=NULL, const std::vector<uint256>* pvHashes=NULL);
 
 /** Check whether enough disk space is available for an incoming block */
 bool CheckDiskSpace(uint64_t nAdditionalBytes = 0);
@@ -348,6 +357,8 @@ bool LoadBlockIndex(const CChainParams& chainparams);
 void UnloadBlockIndex();
 /** Run an instance of the script checking thread */
 void ThreadScriptCheck();
+/** Stop the transaction message signature checking threads, if CheckTxMessageSignatures started them */
+void StopTxMessageCheckThreads();
 /** Check whether we are doing an initial block download (synchronizing from disk or network) */
 bool IsInitialBlockDownload();
 /** Format a string that describes several potential problems detected by the core.
@@ -360,8 +371,8 @@ bool IsInitialBlockDownload();
 std::string GetWarnings(const std::string& strFor);
 /** Retrieve a transaction (from memory pool, or from disk, if possible) */
 bool GetTransaction(const uint256 &hash, CTransactionRef &tx, const Consensus::Params& params, uint256 &hashBlock, bool fAllowSlow = false);
-/** Find the best known block, and make it the tip of the block chain */
-bool ActivateBestChain(CValidationState& state, const CChainParams& chainparams, std::shared_ptr<const CBlock> pblock = std::shared_ptr<const CBlock>());
+/** Find the best known block, and make it the tip of the block chain. pBlockHash is pblock's hash if the caller already computed it */
+bool ActivateBestChain(CValidationState& state, const CChainParams& chainparams, std::shared_ptr<const CBlock> pblock = std::shared_ptr<const CBlock>(), const uint256* pBlockHash = NULL);
 
 double ConvertBitsToDouble(unsigned int nBits);
 CAmount GetBlockSubsidy(int nBits, int nHeight, const Consensus::Params& consensusParams, bool fSuperblockPartOnly = false);
@@ -549,6 +560,39 @@ public:
     ScriptError GetScriptError() const { return error; }
 };
 
+/**
+ * Closure representing the signature check of a GSC transmission or ABN
+ * transaction message, run on its own CCheckQueue the way CScriptCheck is.
+ * The outcome is written to *pfSigned instead of failing the queue, because
+ * callers such as the GSC tally skip unsigned transactions rather than
+ * rejecting the block.
+ */
+class CTxMessageSignatureCheck
+{
+private:
+    CTransactionRef tx;
+    std::string sType;
+    char* pfSigned;
+
+public:
+    CTxMessageSignatureCheck(): pfSigned(nullptr) {}
+    CTxMessageSignatureCheck(const CTransactionRef& txIn, const std::string& sTypeIn, char* pfSignedIn) :
+        tx(txIn), sType(sTypeIn), pfSigned(pfSignedIn) { }
+
+    bool operator()();
+
+    void swap(CTxMessageSignatureCheck &check) {
+        tx.swap(check.tx);
+        sType.swap(check.sType);
+        std::swap(pfSigned, check.pfSigned);
+    }
+};
+
+/** Check the signatures of the GSC transmissions (and optionally the ABN transactions)
+ *  of a block in parallel. The first call starts -par worker threads for this. vGSCSigned[n] is set when block.vtx[n] is a signed GSC
+ *  transmission, (*pvABNSigned)[n] when it is a signed ABN transaction. */
+void CheckTxMessageSignatures(const CBlock& block, std::vector<char>& vGSCSigned, std::vector<char>* pvABNSigned = nullptr);
+
 bool GetTimestampIndex(const unsigned int &high, const unsigned int &low, std::vector<uint256> &hashes);
 bool GetSpentIndex(CSpentIndexKey &key, CSpentIndexValue &value);
 bool GetAddressIndex(uint160 addressHash, int type,
@@ -570,9 +614,9 @@ void ReprocessBlocks(int nBlocks);
 
 /** Context-independent validity checks */
 
-bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, int64_t nBlockTime = 0, int64_t nPrevBlockTime = 0, int nPrevHeight = 0, const CBlockIndex* pindexPrev = NULL);
+bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, int64_t nBlockTime = 0, int64_t nPrevBlockTime = 0, int nPrevHeight = 0, const CBlockIndex* pindexPrev = NULL, const uint256* pBlockHash = NULL);
 
-bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true, int64_t nBlockTime = 0, int64_t nPrevBlockTime = 0, int nPrevHeight = 0, CBlockIndex* pindexPrev = NULL);
+bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true, int64_t nBlockTime = 0, int64_t nPrevBlockTime = 0, int nPrevHeight = 0, CBlockIndex* pindexPrev = NULL, const uint256* pBlockHash = NULL);
 
 
 /** Context-dependent validity checks.